@@ -0,0 +1,406 @@
+/*
+ * bench.cpp - SkipList benchmark suite (make bench)
+ *
+ * Measures insert, find, find_batch, lower_bound, iteration, copy, merge and erase for
+ * SkipList (plain, indexable, with finger), UnrolledSkipList and the std::set / std::map
+ * baselines. The indexable, finger and unrolled variants only run when named in --structures.
+ *
+ * Key patterns:
+ * - seq:    keys inserted, searched and erased in ascending order
+ * - random: keys inserted, searched and erased in shuffled order
+ * - zipf:   keys inserted in shuffled order, searched and erased following a
+ *           Zipfian stream (theta = 0.99) so a few hot keys take most accesses
+ *
+ * Reported per row:
+ * - ns/op   mean wall time per operation (per key for find_batch, per element for
+ *           iteration, copy and merge)
+ * - p50/p99 latency of individually timed operations (a strided sample)
+ * - B/elem  live heap bytes per element after the insert phase
+ *
+ * Usage: output_bench [--sizes 1000,10000,...] [--structures skiplist,indexable,finger,unrolled,set,map]
+ *                     [--patterns seq,random,zipf] [--seed N]
+ *
+ * Author: Ilya Pavlov (st129535@student.spbu.ru)
+ */
+#include "SkipList.h"
+#include "UnrolledSkipList.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Live heap bytes of every container built through CountingAllocator
+static std::size_t live_bytes = 0;
+
+template<typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        live_bytes += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        live_bytes -= n * sizeof(T);
+        std::allocator<T>().deallocate(ptr, n);
+    }
+
+    template<typename U>
+    bool operator==(const CountingAllocator<U>&) const noexcept { return true; }
+};
+
+using Key = std::int64_t;
+using BenchSkipList = SkipList<Key, std::less<>, CountingAllocator<Key>>;
+using BenchIndexable = IndexableSkipList<Key, std::less<>, CountingAllocator<Key>>;
+// SkipList with the search finger switched on
+struct BenchFinger : BenchSkipList
+{
+    BenchFinger() { use_finger(true); }
+};
+using BenchUnrolled = UnrolledSkipList<Key, std::less<>, CountingAllocator<Key>>;
+using BenchSet = std::set<Key, std::less<>, CountingAllocator<Key>>;
+using BenchMap = std::map<Key, Key, std::less<>, CountingAllocator<std::pair<const Key, Key>>>;
+
+// Keeps results observable so the optimizer cannot drop the measured work
+static volatile std::uint64_t sink = 0;
+
+using Clock = std::chrono::steady_clock;
+
+static std::uint64_t elapsed_ns(Clock::time_point from, Clock::time_point to)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+}
+
+// Zipfian ranks in [0, n), Gray et al. "Quickly generating billion-record synthetic databases"
+class ZipfGenerator
+{
+public:
+    ZipfGenerator(std::uint64_t n, double theta) : n(n), theta(theta)
+    {
+        double zeta2 = 1.0 + std::pow(0.5, theta);
+        for (std::uint64_t i = 1; i <= n; ++i)
+        {
+            zetan += 1.0 / std::pow(static_cast<double>(i), theta);
+        }
+        alpha = 1.0 / (1.0 - theta);
+        eta = (1.0 - std::pow(2.0 / static_cast<double>(n), 1.0 - theta)) / (1.0 - zeta2 / zetan);
+        half_pow = 1.0 + std::pow(0.5, theta);
+    }
+
+    template<typename Gen>
+    std::uint64_t operator()(Gen& gen)
+    {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(gen);
+        double uz = u * zetan;
+        if (uz < 1.0) return 0;
+        if (uz < half_pow) return 1;
+        std::uint64_t rank = static_cast<std::uint64_t>(static_cast<double>(n) * std::pow(eta * u - eta + 1.0, alpha));
+        return std::min(rank, n - 1);
+    }
+
+private:
+    std::uint64_t n;
+    double theta;
+    double zetan = 0.0;
+    double alpha = 0.0;
+    double eta = 0.0;
+    double half_pow = 0.0;
+};
+
+// Accumulates the timings of one benchmark row over all repetitions
+struct Measurement
+{
+    std::uint64_t total_ns = 0;
+    std::uint64_t ops = 0;
+    std::vector<std::uint64_t> samples;
+    double bytes_per_element = -1.0;
+
+    // Runs op(i) for i in [0, count), timing every stride-th call on its own
+    template<typename Op>
+    void run(std::size_t count, Op&& op)
+    {
+        std::size_t stride = std::max<std::size_t>(SAMPLE_STRIDE, count / SAMPLES_PER_RUN);
+        Clock::time_point start = Clock::now();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i % stride == 0)
+            {
+                Clock::time_point t0 = Clock::now();
+                op(i);
+                samples.push_back(elapsed_ns(t0, Clock::now()));
+            }else
+            {
+                op(i);
+            }
+        }
+        total_ns += elapsed_ns(start, Clock::now());
+        ops += count;
+    }
+    // Times a bulk operation as a whole and charges it to count elements
+    template<typename Op>
+    void run_bulk(std::size_t count, Op&& op)
+    {
+        Clock::time_point start = Clock::now();
+        op();
+        total_ns += elapsed_ns(start, Clock::now());
+        ops += count;
+    }
+
+    double percentile(double q)
+    {
+        if (samples.empty()) return -1.0;
+        std::size_t index = static_cast<std::size_t>(q * (samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+        return static_cast<double>(samples[index]);
+    }
+
+    static constexpr std::size_t SAMPLE_STRIDE = 8;       // at most one op in 8 pays for the clock reads
+    static constexpr std::size_t SAMPLES_PER_RUN = 1000;  // upper bound on timed ops per repetition
+};
+
+// Key streams shared by every structure for one (pattern, size) pair
+struct Workload
+{
+    std::vector<Key> insert_keys;   // distinct keys, in insertion order
+    std::vector<Key> access_keys;   // keys for find / lower_bound / erase
+};
+
+static Workload make_workload(const std::string& pattern, std::size_t n, std::uint64_t seed)
+{
+    std::mt19937_64 gen(seed);
+    Workload work;
+    // Even keys are stored, lower_bound probes the odd gap right after a stored key
+    work.insert_keys.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        work.insert_keys[i] = static_cast<Key>(2 * i);
+    }
+    if (pattern == "seq")
+    {
+        work.access_keys = work.insert_keys;
+        return work;
+    }
+    std::shuffle(work.insert_keys.begin(), work.insert_keys.end(), gen);
+    if (pattern == "random")
+    {
+        work.access_keys = work.insert_keys;
+        std::shuffle(work.access_keys.begin(), work.access_keys.end(), gen);
+        return work;
+    }
+    // Zipf: rank r maps to the r-th key of the shuffled order, so hot keys are scattered
+    ZipfGenerator zipf(n, 0.99);
+    work.access_keys.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        work.access_keys[i] = work.insert_keys[zipf(gen)];
+    }
+    return work;
+}
+
+// Uniform access to the benchmarked containers (std containers run find_batch as a loop)
+template<typename Container>
+struct Ops
+{
+    static void insert(Container& c, Key key)
+    {
+        if constexpr (requires { typename Container::mapped_type; })
+        {
+            c.emplace(key, key);
+        }else
+        {
+            c.insert(key);
+        }
+    }
+    static Key value(const typename Container::value_type& v)
+    {
+        if constexpr (requires { typename Container::mapped_type; })
+        {
+            return v.second;
+        }else
+        {
+            return v;
+        }
+    }
+    // find over a batch of keys: batched API where the container has one, a plain loop otherwise
+    static std::uint64_t find_batch(Container& c, const Key* keys, std::size_t count)
+    {
+        std::uint64_t sum = 0;
+        if constexpr (requires { c.find_batch(keys, keys, static_cast<typename Container::iterator*>(nullptr)); })
+        {
+            static std::vector<typename Container::iterator> found;
+            found.resize(count);
+            c.find_batch(keys, keys + count, found.begin());
+            for (auto it : found)
+            {
+                if (it != c.end()) sum += value(*it);
+            }
+        }else
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                auto it = c.find(keys[i]);
+                if (it != c.end()) sum += value(*it);
+            }
+        }
+        return sum;
+    }
+    static void merge(Container& into, Container& from)
+    {
+        if constexpr (requires { into.merge(std::move(from)); })
+        {
+            into.merge(std::move(from));
+        }else
+        {
+            into.merge(from);
+        }
+    }
+};
+
+static const char* const OP_NAMES[] = {"insert", "find", "find_batch", "lower_bound", "iterate", "copy", "merge", "erase"};
+static constexpr std::size_t OP_COUNT = sizeof(OP_NAMES) / sizeof(OP_NAMES[0]);
+static constexpr std::size_t BATCH = 1024;  // probes per find_batch call
+
+template<typename Container>
+static void bench_structure(const char* name, const std::string& pattern, std::size_t n, const Workload& work)
+{
+    using O = Ops<Container>;
+    // Small sizes are repeated so every row is backed by at least ~1e6 operations
+    std::size_t reps = std::max<std::size_t>(1, 1000000 / n);
+    Measurement m[OP_COUNT];
+
+    for (std::size_t rep = 0; rep < reps; ++rep)
+    {
+        std::size_t base_bytes = live_bytes;
+        Container c;
+        m[0].run(n, [&](std::size_t i) { O::insert(c, work.insert_keys[i]); });
+        m[0].bytes_per_element = static_cast<double>(live_bytes - base_bytes) / static_cast<double>(n);
+
+        m[1].run(n, [&](std::size_t i) {
+            auto it = c.find(work.access_keys[i]);
+            if (it != c.end()) sink = sink + O::value(*it);
+        });
+        m[2].run_bulk(n, [&] {
+            for (std::size_t from = 0; from < n; from += BATCH)
+            {
+                sink = sink + O::find_batch(c, work.access_keys.data() + from, std::min(BATCH, n - from));
+            }
+        });
+        m[3].run(n, [&](std::size_t i) {
+            auto it = c.lower_bound(work.access_keys[i] + 1);
+            if (it != c.end()) sink = sink + O::value(*it);
+        });
+        m[4].run_bulk(n, [&] {
+            std::uint64_t sum = 0;
+            for (const auto& v : c) sum += O::value(v);
+            sink = sink + sum;
+        });
+        m[5].run_bulk(n, [&] {
+            Container copy(c);
+            sink = sink + copy.size();
+        });
+        // Merge two halves holding alternate keys of the insertion order
+        {
+            Container left, right;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                O::insert(i % 2 ? right : left, work.insert_keys[i]);
+            }
+            m[6].run_bulk(n, [&] {
+                O::merge(left, right);
+                sink = sink + left.size();
+            });
+        }
+        m[7].run(n, [&](std::size_t i) { sink = sink + c.erase(work.access_keys[i]); });
+    }
+
+    for (std::size_t op = 0; op < OP_COUNT; ++op)
+    {
+        double ns = static_cast<double>(m[op].total_ns) / static_cast<double>(m[op].ops);
+        std::printf("%-10s %-7s %10zu %-12s %10.1f", name, pattern.c_str(), n, OP_NAMES[op], ns);
+        if (m[op].samples.empty())
+        {
+            std::printf(" %9s %9s", "-", "-");
+        }else
+        {
+            std::printf(" %9.0f %9.0f", m[op].percentile(0.50), m[op].percentile(0.99));
+        }
+        if (m[op].bytes_per_element >= 0.0)
+        {
+            std::printf(" %8.1f\n", m[op].bytes_per_element);
+        }else
+        {
+            std::printf(" %8s\n", "-");
+        }
+    }
+    std::fflush(stdout);
+}
+
+static std::vector<std::string> split_list(const std::string& text)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ','))
+    {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+static bool contains_name(const std::vector<std::string>& names, const std::string& name)
+{
+    return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> sizes = {"1000", "10000", "100000", "1000000"};
+    std::vector<std::string> structures = {"skiplist", "set", "map"};
+    std::vector<std::string> patterns = {"seq", "random", "zipf"};
+    std::uint64_t seed = 42;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string flag = argv[i];
+        if (flag == "--sizes") sizes = split_list(argv[i + 1]);
+        else if (flag == "--structures") structures = split_list(argv[i + 1]);
+        else if (flag == "--patterns") patterns = split_list(argv[i + 1]);
+        else if (flag == "--seed") seed = std::stoull(argv[i + 1]);
+        else
+        {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    std::printf("%-10s %-7s %10s %-12s %10s %9s %9s %8s\n", "structure", "pattern", "n", "op", "ns/op", "p50", "p99", "B/elem");
+    for (const std::string& size : sizes)
+    {
+        std::size_t n = std::stoull(size);
+        for (const std::string& pattern : patterns)
+        {
+            Workload work = make_workload(pattern, n, seed);
+            if (contains_name(structures, "skiplist")) bench_structure<BenchSkipList>("skiplist", pattern, n, work);
+            if (contains_name(structures, "indexable")) bench_structure<BenchIndexable>("indexable", pattern, n, work);
+            if (contains_name(structures, "finger")) bench_structure<BenchFinger>("finger", pattern, n, work);
+            if (contains_name(structures, "unrolled")) bench_structure<BenchUnrolled>("unrolled", pattern, n, work);
+            if (contains_name(structures, "set")) bench_structure<BenchSet>("set", pattern, n, work);
+            if (contains_name(structures, "map")) bench_structure<BenchMap>("map", pattern, n, work);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,617 @@
+/*
+ * ConcurrentSkipList.h - Lock-free concurrent skip list
+ *
+ * Features:
+ * - Same set-like API as SkipList: insert, find, contains, erase, lower_bound, iteration
+ * - Lock-free insert and erase: towers are linked with CAS, erased towers are first
+ *   marked (low bit of their forward pointers) and then unlinked by any thread that
+ *   passes them
+ * - Wait-free lookups that never write to shared memory
+ * - Epoch-based reclamation: unlinked towers are freed once no thread can still see them
+ *
+ * Thread-safety:
+ * - All member functions except construction and destruction may be called concurrently
+ * - Iterators pin the calling thread's epoch; they must be used and destroyed on the
+ *   thread that created them and should not be held for long
+ * - Iteration is weakly consistent: it sees every element present for its whole
+ *   duration and may or may not see concurrent changes
+ * - size() is exact only when no operation is in flight
+ *
+ * Author: Ilya Pavlov (st129535@student.spbu.ru)
+ *
+ * ConcurrentSkipList Invariants:
+ * 1. Unmarked towers on each level form a sorted linked list ending at nullptr
+ * 2. A tower is logically deleted once its bottom-level pointer is marked
+ * 3. A tower is retired only when both its inserter and its eraser are done with it
+ */
+#ifndef CONCURRENT_SKIPLIST_H
+#define CONCURRENT_SKIPLIST_H
+
+#include "SkipList.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Aligned to the forward pointer word so the inline atomics never straddle cache lines
+template<typename T>
+class alignas(std::atomic<std::uintptr_t>) ConcurrentSkipNode
+{
+public:
+    T data;                     // The data stored in this tower
+    int height = 1;             // Number of levels this tower is linked into
+    std::atomic<int> owners;    // Inserting thread + membership; the last one to let go retires the tower
+
+    template <typename... Args>
+    explicit ConcurrentSkipNode(int h, Args&&... args) : data(std::forward<Args>(args)...), height(h), owners(2) {}
+    ~ConcurrentSkipNode() = default;
+
+    // Forward pointers (tower address | deleted mark) are stored inline after the node
+    std::atomic<std::uintptr_t>* forward() noexcept { return reinterpret_cast<std::atomic<std::uintptr_t>*>(this + 1); }
+    std::atomic<std::uintptr_t>& next(int level) noexcept { return forward()[level - 1]; }
+};
+
+// Allocation unit for concurrent towers
+template<typename T>
+struct alignas(ConcurrentSkipNode<T>) ConcurrentSkipNodeWord
+{
+    unsigned char bytes[alignof(ConcurrentSkipNode<T>)];
+};
+
+// Source of per-instance ids, so thread-local caches never confuse two lists
+struct ConcurrentSkipListIds
+{
+    static std::uint64_t next() noexcept
+    {
+        static std::atomic<std::uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+};
+
+template<typename T, typename Compare = std::less<>, typename Allocator = std::allocator<T>>
+class ConcurrentSkipList
+{
+    using Node = ConcurrentSkipNode<T>;
+    struct ThreadRecord;
+
+    // Keeps the calling thread's epoch pinned while alive (re-entrant)
+    class Guard
+    {
+    public:
+        Guard() = default;
+        explicit Guard(const ConcurrentSkipList* owner) : list(owner), record(owner->localRecord()) { list->pin(record); }
+        Guard(const Guard& other) : list(other.list), record(other.record) { if (record) list->pin(record); }
+        Guard(Guard&& other) noexcept : list(other.list), record(std::exchange(other.record, nullptr)) {}
+        Guard& operator=(Guard other) noexcept
+        {
+            std::swap(list, other.list);
+            std::swap(record, other.record);
+            return *this;
+        }
+        ~Guard() { if (record) list->unpin(record); }
+
+        ThreadRecord* thread_record() const noexcept { return record; }
+
+    private:
+        const ConcurrentSkipList* list = nullptr;
+        ThreadRecord* record = nullptr;
+    };
+
+public:
+    static constexpr int MAX_LVL = 32;
+
+    // Iterators are read-only and weakly consistent
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = const T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return current->data; }
+        pointer operator->() const { return &current->data; }
+
+        const_iterator& operator++()
+        {
+            if (current) current = nextLive(current);
+            if (!current) guard = Guard();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const { return current == other.current; }
+        bool operator!=(const const_iterator& other) const { return current != other.current; }
+
+    private:
+        friend class ConcurrentSkipList;
+        const_iterator(Node* node, Guard&& pin) : current(node), guard(node ? std::move(pin) : Guard()) {}
+        Node* current = nullptr;
+        Guard guard;
+    };
+    using iterator = const_iterator;
+
+    //types initialization
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<ConcurrentSkipNodeWord<T>>;
+    using allocator_type = Allocator;
+
+    // Constructor and destructor
+    explicit ConcurrentSkipList(const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : _alloc(alloc),
+          _node_alloc(alloc),
+          _comp(comp),
+          _uid(ConcurrentSkipListIds::next())
+    {
+        head = create_node(MAX_LVL);
+    }
+    ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+    ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+    // Destructor, must not run concurrently with any other member function
+    ~ConcurrentSkipList()
+    {
+        Node* node = head;
+        while (node)
+        {
+            Node* next_node = address(node->next(1).load(std::memory_order_relaxed));
+            delete_node(node);
+            node = next_node;
+        }
+        ThreadRecord* record = records.load(std::memory_order_acquire);
+        while (record)
+        {
+            ThreadRecord* next_record = record->next;
+            for (auto& bucket : record->limbo)
+            {
+                for (Node* retired : bucket) delete_node(retired);
+            }
+            delete record;
+            record = next_record;
+        }
+    }
+
+    Allocator get_allocator() const { return _alloc; }
+    Compare key_comp() const { return _comp; }
+
+    // Iterator access methods
+    const_iterator begin() const
+    {
+        Guard guard(this);
+        return const_iterator(nextLive(head), std::move(guard));
+    }
+    const_iterator end() const noexcept { return const_iterator(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Number of elements (exact when no operation is in flight)
+    size_t size() const noexcept { return _size.load(std::memory_order_relaxed); }
+    bool empty() const
+    {
+        Guard guard(this);
+        return nextLive(head) == nullptr;
+    }
+
+    // Insert element
+    /*
+     * Insertion Algorithm (Herlihy & Shavit, lock-free skip list):
+     * 1. Find predecessors/successors on every level, unlinking marked towers on the way
+     * 2. Return the existing tower if the key is present
+     * 3. Link the tower on the bottom level with CAS; on failure search again
+     * 4. Link the upper levels one by one, refreshing the search after each failed CAS
+     *    and giving up once the tower has been marked by a concurrent erase
+     */
+    std::pair<iterator, bool> insert(const T& value) { return insertUnique(value, value); }
+    std::pair<iterator, bool> insert(T&& value) { return insertUnique(value, std::move(value)); }
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        T value(std::forward<Args>(args)...);
+        return insertUnique(value, std::move(value));
+    }
+    // Range insert
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first) insert(*first);
+    }
+
+    // Erase by value
+    /*
+     * Upper levels are marked top-down, then whoever marks the bottom level owns
+     * the deletion; a final search unlinks the tower from every level.
+     */
+    template <typename K>
+    bool erase(const K& key)
+    {
+        Guard guard(this);
+        search_path preds, succs;
+        if (!findPosition(key, preds.data(), succs.data(), 1)) return false;
+
+        Node* victim = succs[1];
+        for (int l = victim->height; l >= 2; --l)
+        {
+            std::uintptr_t succ = victim->next(l).load();
+            while (!marked(succ) && !victim->next(l).compare_exchange_weak(succ, succ | 1)) {}
+        }
+        std::uintptr_t succ = victim->next(1).load();
+        while (true)
+        {
+            if (marked(succ)) return false;
+            if (victim->next(1).compare_exchange_weak(succ, succ | 1))
+            {
+                _size.fetch_sub(1, std::memory_order_relaxed);
+                findPosition(key, preds.data(), succs.data(), 1);
+                release(victim, guard.thread_record());
+                return true;
+            }
+        }
+    }
+
+    // Find element
+    template <typename K>
+    const_iterator find(const K& key) const
+    {
+        Guard guard(this);
+        Node* node = lowerBoundNode(key);
+        if (node && !_comp(key, node->data)) return const_iterator(node, std::move(guard));
+        return end();
+    }
+    // Check for existence
+    template <typename K>
+    bool contains(const K& key) const
+    {
+        Guard guard(this);
+        Node* node = lowerBoundNode(key);
+        return node && !_comp(key, node->data);
+    }
+    // First not less than key
+    template <typename K>
+    const_iterator lower_bound(const K& key) const
+    {
+        Guard guard(this);
+        return const_iterator(lowerBoundNode(key), std::move(guard));
+    }
+    // First greater than key
+    template <typename K>
+    const_iterator upper_bound(const K& key) const
+    {
+        const_iterator it = lower_bound(key);
+        return (it != end() && !_comp(key, *it)) ? ++it : it;
+    }
+
+    // Check if container is correct, must not run concurrently with modifications
+    bool validate() const
+    {
+        size_t count = 0;
+        for (int l = 1; l <= MAX_LVL; ++l)
+        {
+            Node* prev = nullptr;
+            for (Node* node = address(head->next(l).load()); node; node = address(node->next(l).load()))
+            {
+                if (marked(node->next(l).load())) return false;
+                if (node->height < l) return false;
+                if (prev && !_comp(prev->data, node->data)) return false;
+                if (l == 1) ++count;
+                prev = node;
+            }
+        }
+        return count == size();
+    }
+
+private:
+    using search_path = std::array<Node*, MAX_LVL + 1>;
+
+    // Per-thread reclamation state, registered with the list on first use
+    struct ThreadRecord
+    {
+        std::atomic<std::uint64_t> epoch{0};    // (global epoch << 1) | 1 while pinned, 0 otherwise
+        std::thread::id owner;
+        ThreadRecord* next = nullptr;
+        int nest = 0;                           // Guards alive on this thread
+        std::vector<Node*> limbo[3];            // Retired towers, bucketed by retirement epoch
+        std::uint64_t limbo_epoch[3] = {0, 0, 0};
+        size_t retired = 0;
+        SkipLevelGenerator level_gen;
+    };
+
+    static constexpr size_t ADVANCE_EVERY = 64;  // retirements between epoch advance attempts
+
+    Allocator _alloc;
+    mutable node_allocator _node_alloc;
+    Compare _comp;
+    Node* head;
+    std::atomic<int> top_level{1};
+    std::atomic<size_t> _size{0};
+    mutable std::atomic<ThreadRecord*> records{nullptr};
+    mutable std::atomic<std::uint64_t> global_epoch{1};
+    std::uint64_t _uid;
+
+    // Marked pointer helpers
+    static Node* address(std::uintptr_t link) noexcept { return reinterpret_cast<Node*>(link & ~std::uintptr_t(1)); }
+    static bool marked(std::uintptr_t link) noexcept { return link & 1; }
+    static std::uintptr_t link_to(Node* node) noexcept { return reinterpret_cast<std::uintptr_t>(node); }
+
+    // Number of allocation units occupied by a tower of the given height
+    static constexpr size_t node_units(int height) noexcept
+    {
+        return (sizeof(Node) + height * sizeof(std::atomic<std::uintptr_t>) + sizeof(ConcurrentSkipNodeWord<T>) - 1) / sizeof(ConcurrentSkipNodeWord<T>);
+    }
+    // Creates a new tower of given height
+    template <typename... Args>
+    Node* create_node(int height, Args&&... args) const
+    {
+        ConcurrentSkipNodeWord<T>* raw = std::allocator_traits<node_allocator>::allocate(_node_alloc, node_units(height));
+        Node* node = reinterpret_cast<Node*>(raw);
+        try
+        {
+            std::allocator_traits<node_allocator>::construct(_node_alloc, node, height, std::forward<Args>(args)...);
+        }catch(...)
+        {
+            std::allocator_traits<node_allocator>::deallocate(_node_alloc, raw, node_units(height));
+            throw;
+        }
+        for (int l = 1; l <= height; ++l)
+        {
+            std::construct_at(&node->next(l), std::uintptr_t(0));
+        }
+        return node;
+    }
+    // Properly deallocates a tower using the allocator
+    void delete_node(Node* node) const noexcept
+    {
+        size_t units = node_units(node->height);
+        std::allocator_traits<node_allocator>::destroy(_node_alloc, node);
+        std::allocator_traits<node_allocator>::deallocate(_node_alloc, reinterpret_cast<ConcurrentSkipNodeWord<T>*>(node), units);
+    }
+
+    // First tower after node whose bottom level is not marked
+    static Node* nextLive(Node* node) noexcept
+    {
+        Node* next_node = address(node->next(1).load());
+        while (next_node && marked(next_node->next(1).load()))
+        {
+            next_node = address(next_node->next(1).load());
+        }
+        return next_node;
+    }
+    // Wait-free search: first live tower not less than key, marked towers are skipped
+    template <typename K>
+    Node* lowerBoundNode(const K& key) const
+    {
+        Node* pred = head;
+        Node* curr = nullptr;
+        for (int l = top_level.load(); l >= 1; --l)
+        {
+            curr = address(pred->next(l).load());
+            while (curr)
+            {
+                std::uintptr_t succ = curr->next(l).load();
+                while (curr && marked(succ))
+                {
+                    curr = address(succ);
+                    if (curr) succ = curr->next(l).load();
+                }
+                if (curr && _comp(curr->data, key))
+                {
+                    pred = curr;
+                    curr = address(succ);
+                }else
+                {
+                    break;
+                }
+            }
+        }
+        return curr;
+    }
+    // Fills preds/succs on levels 1..max(top_level, min_level), unlinking marked towers
+    // on the way; returns true if succs[1] holds key
+    template <typename K>
+    bool findPosition(const K& key, Node** preds, Node** succs, int min_level)
+    {
+        int top = top_level.load();
+        if (top < min_level) top = min_level;
+        bool restart = true;
+        while (restart)
+        {
+            restart = false;
+            Node* pred = head;
+            for (int l = top; l >= 1 && !restart; --l)
+            {
+                Node* curr = address(pred->next(l).load());
+                while (curr)
+                {
+                    std::uintptr_t succ = curr->next(l).load();
+                    while (marked(succ))
+                    {
+                        std::uintptr_t expected = link_to(curr);
+                        if (!pred->next(l).compare_exchange_strong(expected, succ & ~std::uintptr_t(1)))
+                        {
+                            restart = true;
+                            break;
+                        }
+                        curr = address(succ);
+                        if (!curr) break;
+                        succ = curr->next(l).load();
+                    }
+                    if (restart || !curr) break;
+                    if (_comp(curr->data, key))
+                    {
+                        pred = curr;
+                        curr = address(succ);
+                    }else
+                    {
+                        break;
+                    }
+                }
+                preds[l] = pred;
+                succs[l] = curr;
+            }
+        }
+        return succs[1] && !_comp(key, succs[1]->data);
+    }
+    // Shared insert path: search by key, build the tower from args only if absent
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> insertUnique(const K& key, Args&&... args)
+    {
+        Guard guard(this);
+        ThreadRecord* record = guard.thread_record();
+        search_path preds, succs;
+        int height = record->level_gen(MAX_LVL);
+        Node* node = nullptr;
+        while (true)
+        {
+            bool found = node ? findPosition(node->data, preds.data(), succs.data(), height)
+                              : findPosition(key, preds.data(), succs.data(), height);
+            if (found)
+            {
+                if (node) delete_node(node);
+                return {const_iterator(succs[1], std::move(guard)), false};
+            }
+            if (!node) node = create_node(height, std::forward<Args>(args)...);
+            for (int l = 1; l <= height; ++l)
+            {
+                node->next(l).store(link_to(succs[l]), std::memory_order_relaxed);
+            }
+            std::uintptr_t expected = link_to(succs[1]);
+            if (preds[1]->next(1).compare_exchange_strong(expected, link_to(node))) break;
+        }
+        _size.fetch_add(1, std::memory_order_relaxed);
+        int top = top_level.load();
+        while (top < height && !top_level.compare_exchange_weak(top, height)) {}
+
+        for (int l = 2; l <= height; ++l)
+        {
+            bool abandoned = false;
+            while (true)
+            {
+                // The tower must point at the current successor before it is linked:
+                // a refreshed search may have replaced succs[l] since it was stored
+                std::uintptr_t own = node->next(l).load();
+                if (marked(own))
+                {
+                    abandoned = true;
+                    break;
+                }
+                if (own != link_to(succs[l]) && !node->next(l).compare_exchange_strong(own, link_to(succs[l]))) continue;
+                std::uintptr_t expected = link_to(succs[l]);
+                if (preds[l]->next(l).compare_exchange_strong(expected, link_to(node))) break;
+                findPosition(node->data, preds.data(), succs.data(), height);
+            }
+            if (abandoned) break;
+        }
+        // An erase may have marked the tower while upper levels were being linked
+        if (marked(node->next(1).load()))
+        {
+            findPosition(node->data, preds.data(), succs.data(), height);
+        }
+        release(node, record);
+        return {const_iterator(node, std::move(guard)), true};
+    }
+
+    // Drops one owner of a published tower, retiring it when no owner is left
+    void release(Node* node, ThreadRecord* record)
+    {
+        if (node->owners.fetch_sub(1) == 1)
+        {
+            retire(node, record);
+        }
+    }
+
+    // Epoch-based reclamation
+    /*
+     * A tower retired while the global epoch is E may still be referenced by threads
+     * pinned at E or earlier; once the global epoch reaches E + 2 every pinned thread
+     * entered after the tower became unreachable, so it can be freed.
+     */
+    ThreadRecord* localRecord() const
+    {
+        struct Cache
+        {
+            std::uint64_t list = 0;
+            ThreadRecord* record = nullptr;
+        };
+        thread_local Cache cache;
+        if (cache.list == _uid) return cache.record;
+
+        std::thread::id self = std::this_thread::get_id();
+        ThreadRecord* record = records.load(std::memory_order_acquire);
+        while (record && record->owner != self) record = record->next;
+        if (!record)
+        {
+            record = new ThreadRecord;
+            record->owner = self;
+            record->next = records.load(std::memory_order_relaxed);
+            while (!records.compare_exchange_weak(record->next, record, std::memory_order_release, std::memory_order_relaxed)) {}
+        }
+        cache = {_uid, record};
+        return record;
+    }
+    void pin(ThreadRecord* record) const
+    {
+        if (record->nest++ > 0) return;
+        std::uint64_t epoch = global_epoch.load();
+        while (true)
+        {
+            record->epoch.store((epoch << 1) | 1);
+            std::uint64_t now = global_epoch.load();
+            if (now == epoch) break;
+            epoch = now;
+        }
+        for (int b = 0; b < 3; ++b)
+        {
+            if (!record->limbo[b].empty() && record->limbo_epoch[b] + 2 <= epoch) freeBucket(record, b);
+        }
+    }
+    void unpin(ThreadRecord* record) const noexcept
+    {
+        if (--record->nest == 0) record->epoch.store(0);
+    }
+    void retire(Node* node, ThreadRecord* record)
+    {
+        std::uint64_t epoch = global_epoch.load();
+        int b = static_cast<int>(epoch % 3);
+        if (record->limbo_epoch[b] != epoch)
+        {
+            // Same bucket, at least three epochs older
+            freeBucket(record, b);
+            record->limbo_epoch[b] = epoch;
+        }
+        record->limbo[b].push_back(node);
+        if (++record->retired % ADVANCE_EVERY == 0) tryAdvance();
+    }
+    void freeBucket(ThreadRecord* record, int b) const noexcept
+    {
+        for (Node* node : record->limbo[b]) delete_node(node);
+        record->limbo[b].clear();
+    }
+    // Moves the global epoch forward if every pinned thread has observed it
+    void tryAdvance() const noexcept
+    {
+        std::uint64_t epoch = global_epoch.load();
+        for (ThreadRecord* record = records.load(std::memory_order_acquire); record; record = record->next)
+        {
+            std::uint64_t local = record->epoch.load();
+            if ((local & 1) && (local >> 1) != epoch) return;
+        }
+        global_epoch.compare_exchange_strong(epoch, epoch + 1);
+    }
+};
+
+#endif
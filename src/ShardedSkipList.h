@@ -0,0 +1,427 @@
+/*
+ * ShardedSkipList.h - Range-partitioned SkipList with a reader-writer lock per shard
+ *
+ * Features:
+ * - Same set-like API as SkipList: insert, emplace, find, contains, erase, lower_bound,
+ *   upper_bound, ordered iteration across all shards
+ * - The keyspace is cut at boundary keys into shards, each a SkipList behind its own
+ *   std::shared_mutex: writers to different shards never wait for each other and
+ *   readers of a shard share its lock
+ * - split_shard, merge_shards and rebalance move boundaries online with the O(log n)
+ *   split and join of SkipList, briefly blocking every shard
+ *
+ * Thread-safety:
+ * - All member functions except construction and destruction may be called concurrently
+ * - Iterators hold no locks: lookups copy the one element they found, and advancing
+ *   copies the next short run of elements after the last key seen under the shard
+ *   lock, so iteration is weakly consistent
+ *   like ConcurrentSkipList (it sees every element present for its whole duration) and
+ *   dereferenced elements are copies that stay valid while the iterator does
+ * - The allocator is used by several shards at once and must allow that (std::allocator)
+ * - size() is exact only when no operation is in flight
+ *
+ * Author: Ilya Pavlov (st129535@student.spbu.ru)
+ *
+ * ShardedSkipList Invariants:
+ * 1. Boundaries are strictly increasing; shard i holds keys in [bound(i-1), bound(i))
+ * 2. There is always one more shard than boundaries
+ */
+#ifndef SHARDED_SKIPLIST_H
+#define SHARDED_SKIPLIST_H
+
+#include "SkipList.h"
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+template<typename T, typename Compare = std::less<>, typename Allocator = std::allocator<T>>
+class ShardedSkipList
+{
+    using list_type = SkipList<T, Compare, Allocator>;
+    // One lock and list per cache line pair, so neighbouring shards do not share lines
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex lock;
+        list_type list;
+
+        Shard(const Compare& comp, const Allocator& alloc) : list(comp, alloc) {}
+        explicit Shard(list_type&& elements) : list(std::move(elements)) {}
+    };
+    // Elements an advancing iterator copies per shard visit
+    static constexpr size_t RUN_LENGTH = 64;
+
+public:
+    // Read-only forward iterator over copies of the elements, see Thread-safety
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return run ? (*run)[pos] : *hit; }
+        pointer operator->() const { return &**this; }
+
+        // Past the found element or the end of the run, the next run is fetched
+        const_iterator& operator++()
+        {
+            if (run && ++pos < run->size()) return *this;
+            run_type next = owner->runAfter(run ? (*run)[pos - 1] : *hit);
+            hit.reset();
+            run = next->empty() ? nullptr : std::move(next);
+            pos = 0;
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        // Iterators at equivalent elements are equal, whichever lookup made them
+        bool operator==(const const_iterator& other) const
+        {
+            if (atEnd() || other.atEnd()) return atEnd() && other.atEnd();
+            return !owner->_comp(**this, *other) && !owner->_comp(*other, **this);
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class ShardedSkipList;
+        using run_type = std::shared_ptr<const std::vector<T>>;
+        const_iterator(const ShardedSkipList* list, std::optional<T> element) : owner(list), hit(std::move(element)) {}
+        bool atEnd() const noexcept { return !run && !hit; }
+        const ShardedSkipList* owner = nullptr;
+        std::optional<T> hit;      // element found by a lookup, until the first advance
+        run_type run;              // elements copied by the last advance; both empty at end()
+        size_t pos = 0;
+    };
+    using iterator = const_iterator;
+
+    //types initialization
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type = Allocator;
+
+    // Constructors and destructor
+    explicit ShardedSkipList(const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : ShardedSkipList(std::vector<T>(), comp, alloc)
+    {
+    }
+    // One shard per range between consecutive boundaries, which must be strictly increasing
+    explicit ShardedSkipList(std::vector<T> boundaries, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : _comp(comp), _alloc(alloc), _bounds(std::move(boundaries))
+    {
+        for (size_t i = 1; i < _bounds.size(); ++i)
+        {
+            if (!_comp(_bounds[i - 1], _bounds[i]))
+            {
+                throw std::invalid_argument("ShardedSkipList: boundaries must be strictly increasing");
+            }
+        }
+        for (size_t i = 0; i <= _bounds.size(); ++i)
+        {
+            _shards.push_back(std::make_unique<Shard>(_comp, _alloc));
+        }
+    }
+    // Shards are locked in place, so the list is neither copied nor moved
+    ShardedSkipList(const ShardedSkipList&) = delete;
+    ShardedSkipList& operator=(const ShardedSkipList&) = delete;
+    ~ShardedSkipList() = default;
+
+    Allocator get_allocator() const { return _alloc; }
+    Compare key_comp() const { return _comp; }
+
+    // Iterator access methods
+    const_iterator begin() const { return const_iterator(this, firstFrom(static_cast<const T*>(nullptr), false)); }
+    const_iterator end() const noexcept { return const_iterator(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Number of elements (exact when no operation is in flight)
+    size_t size() const noexcept { return _size.load(std::memory_order_relaxed); }
+    bool empty() const noexcept { return size() == 0; }
+
+    // Insert element into the shard owning its key
+    std::pair<iterator, bool> insert(const T& value) { return insertUnique(value, value); }
+    std::pair<iterator, bool> insert(T&& value) { return insertUnique(value, std::move(value)); }
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        T value(std::forward<Args>(args)...);
+        return insertUnique(value, std::move(value));
+    }
+    // Range insert
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first) insert(*first);
+    }
+
+    // Erase by value
+    template <typename K>
+    bool erase(const K& key)
+    {
+        std::shared_lock table(_table_lock);
+        Shard& shard = shardOf(key);
+        std::unique_lock lock(shard.lock);
+        if (!shard.list.erase(key)) return false;
+        _size.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    // Erase by iterator, returns the iterator following pos
+    iterator erase(const_iterator pos)
+    {
+        if (pos == end())
+        {
+            throw std::out_of_range("Cannot erase end() iterator");
+        }
+        erase(*pos);
+        return const_iterator(this, firstFrom(&*pos, true));
+    }
+    // Erase all elements
+    void clear()
+    {
+        std::shared_lock table(_table_lock);
+        for (auto& shard : _shards)
+        {
+            std::unique_lock lock(shard->lock);
+            _size.fetch_sub(shard->list.size(), std::memory_order_relaxed);
+            shard->list.clear();
+        }
+    }
+
+    // Find element, looking only at the shard owning key
+    template <typename K>
+    const_iterator find(const K& key) const
+    {
+        std::shared_lock table(_table_lock);
+        const Shard& shard = shardOf(key);
+        std::shared_lock lock(shard.lock);
+        auto it = shard.list.find(key);
+        return const_iterator(this, it == shard.list.end() ? std::nullopt : std::optional<T>(*it));
+    }
+    // Check for existence
+    template <typename K>
+    bool contains(const K& key) const
+    {
+        std::shared_lock table(_table_lock);
+        const Shard& shard = shardOf(key);
+        std::shared_lock lock(shard.lock);
+        return shard.list.contains(key);
+    }
+    // First not less than key, continuing into the following shards if needed
+    template <typename K>
+    const_iterator lower_bound(const K& key) const { return const_iterator(this, firstFrom(&key, false)); }
+    // First greater than key
+    template <typename K>
+    const_iterator upper_bound(const K& key) const { return const_iterator(this, firstFrom(&key, true)); }
+
+    // Shard layout
+    size_t shard_count() const
+    {
+        std::shared_lock table(_table_lock);
+        return _shards.size();
+    }
+    std::vector<T> boundaries() const
+    {
+        std::shared_lock table(_table_lock);
+        return _bounds;
+    }
+    std::vector<size_t> shard_sizes() const
+    {
+        std::shared_lock table(_table_lock);
+        std::vector<size_t> sizes;
+        for (const auto& shard : _shards)
+        {
+            std::shared_lock lock(shard->lock);
+            sizes.push_back(shard->list.size());
+        }
+        return sizes;
+    }
+
+    // Moves the elements of the shard holding key that are not less than key into a new
+    // shard right after it, in O(log n); does nothing if key already is a boundary
+    template <typename K>
+    void split_shard(const K& key)
+    {
+        std::unique_lock table(_table_lock);
+        size_t index = shardIndex(key);
+        if (index > 0 && !_comp(_bounds[index - 1], key)) return;
+        splitAt(index, T(key));
+    }
+    // Joins shard index + 1 into shard index, in O(log n)
+    void merge_shards(size_t index)
+    {
+        std::unique_lock table(_table_lock);
+        if (index + 1 >= _shards.size())
+        {
+            throw std::out_of_range("merge_shards: no shard after index");
+        }
+        joinNext(index);
+    }
+    // Moves the boundaries so that shards shards hold about the same number of elements
+    /*
+     * The new boundary keys are sampled under the shard locks while writers carry on;
+     * then, with every shard blocked, each old boundary that is not kept is removed by
+     * joining its two shards and each new one is added by splitting, O(log n) apiece.
+     */
+    void rebalance(size_t shards)
+    {
+        if (shards == 0)
+        {
+            throw std::invalid_argument("rebalance: at least one shard is needed");
+        }
+        std::vector<T> keys = sampleBoundaries(shards);
+        std::unique_lock table(_table_lock);
+        for (size_t index = 0; index + 1 < _shards.size();)
+        {
+            if (std::binary_search(keys.begin(), keys.end(), _bounds[index], _comp)) ++index;
+            else joinNext(index);
+        }
+        for (T& key : keys)
+        {
+            size_t index = shardIndex(key);
+            if (index == 0 || _comp(_bounds[index - 1], key)) splitAt(index, std::move(key));
+        }
+    }
+
+    // Check that every shard is correct and holds only keys of its range
+    bool validate() const
+    {
+        std::unique_lock table(_table_lock);
+        size_t count = 0;
+        for (size_t i = 0; i < _shards.size(); ++i)
+        {
+            const list_type& list = _shards[i]->list;
+            if (!list.validate()) return false;
+            count += list.size();
+            if (list.empty()) continue;
+            if (i > 0 && _comp(*list.begin(), _bounds[i - 1])) return false;
+            if (i < _bounds.size() && !_comp(*std::prev(list.end()), _bounds[i])) return false;
+        }
+        return _shards.size() == _bounds.size() + 1 && count == size();
+    }
+
+private:
+    Compare _comp;
+    Allocator _alloc;
+    // Guards the shard table: shared for element operations, exclusive to move boundaries
+    mutable std::shared_mutex _table_lock;
+    std::vector<T> _bounds;
+    std::vector<std::unique_ptr<Shard>> _shards;
+    std::atomic<size_t> _size{0};
+
+    // Shard whose range holds key; the table lock must be held
+    template <typename K>
+    size_t shardIndex(const K& key) const
+    {
+        return std::upper_bound(_bounds.begin(), _bounds.end(), key,
+                                [this](const K& k, const T& bound) { return _comp(k, bound); }) - _bounds.begin();
+    }
+    template <typename K>
+    Shard& shardOf(const K& key) const { return *_shards[shardIndex(key)]; }
+
+    template <typename K, typename V>
+    std::pair<iterator, bool> insertUnique(const K& key, V&& value)
+    {
+        std::shared_lock table(_table_lock);
+        Shard& shard = shardOf(key);
+        std::unique_lock lock(shard.lock);
+        auto [it, inserted] = shard.list.insert(std::forward<V>(value));
+        if (inserted) _size.fetch_add(1, std::memory_order_relaxed);
+        return {const_iterator(this, *it), inserted};
+    }
+    // Copies elements from the first one not less than *key (greater if strict, the very
+    // first if key is nullptr) into sink, which returns false when it has enough; moves
+    // on through later shards only while the shards seen so far had nothing to give
+    template <typename K, typename Sink>
+    void copyFrom(const K* key, bool strict, Sink sink) const
+    {
+        std::shared_lock table(_table_lock);
+        const size_t start = key ? shardIndex(*key) : 0;
+        for (size_t index = start; index < _shards.size(); ++index)
+        {
+            const Shard& shard = *_shards[index];
+            std::shared_lock lock(shard.lock);
+            auto it = shard.list.begin();
+            // Later shards hold only keys greater than key
+            if (key && index == start)
+            {
+                it = strict ? shard.list.upper_bound(*key) : shard.list.lower_bound(*key);
+            }
+            if (it == shard.list.end()) continue;
+            while (it != shard.list.end() && sink(*it)) ++it;
+            return;
+        }
+    }
+    // The first such element alone, for lookups
+    template <typename K>
+    std::optional<T> firstFrom(const K* key, bool strict) const
+    {
+        std::optional<T> first;
+        copyFrom(key, strict, [&first](const T& value) { first.emplace(value); return false; });
+        return first;
+    }
+    // Up to RUN_LENGTH elements after last, for advancing iterators
+    std::shared_ptr<const std::vector<T>> runAfter(const T& last) const
+    {
+        auto run = std::make_shared<std::vector<T>>();
+        copyFrom(&last, true, [&run](const T& value) { run->push_back(value); return run->size() < RUN_LENGTH; });
+        return run;
+    }
+
+    // Splits shard index at key, which lies strictly inside its range; the table lock
+    // must be held exclusively
+    void splitAt(size_t index, T key)
+    {
+        list_type upper = _shards[index]->list.split(key);
+        _shards.insert(_shards.begin() + index + 1, std::make_unique<Shard>(std::move(upper)));
+        _bounds.insert(_bounds.begin() + index, std::move(key));
+    }
+    // Joins shard index + 1 into shard index; the table lock must be held exclusively
+    void joinNext(size_t index)
+    {
+        _shards[index]->list.join(std::move(_shards[index + 1]->list));
+        _shards.erase(_shards.begin() + index + 1);
+        _bounds.erase(_bounds.begin() + index);
+    }
+    // Keys at every size / shards-th position, read shard by shard under shared locks
+    std::vector<T> sampleBoundaries(size_t shards) const
+    {
+        std::vector<T> keys;
+        std::shared_lock table(_table_lock);
+        const size_t total = size();
+        size_t position = 0;
+        for (const auto& shard : _shards)
+        {
+            std::shared_lock lock(shard->lock);
+            for (const T& value : shard->list)
+            {
+                if (keys.size() + 1 < shards && position == total * (keys.size() + 1) / shards && position > 0)
+                {
+                    if (keys.empty() || _comp(keys.back(), value)) keys.push_back(value);
+                }
+                ++position;
+            }
+        }
+        return keys;
+    }
+};
+
+#endif
@@ -0,0 +1,575 @@
+/*
+ * SingleWriterSkipList.h - Skip list with lock-free optimistic readers and one writer at a time
+ *
+ * Features:
+ * - Same set-like API as SkipList: insert, emplace, erase, find, contains, lower_bound,
+ *   upper_bound, forward iteration
+ * - Writers take a mutex among themselves and publish towers bottom-up with release
+ *   stores; readers take no lock and write no shared memory
+ * - Every tower carries a seqlock version: the writer makes it odd while it rewrites
+ *   the tower's forward pointers and leaves it odd once the tower is erased, and a
+ *   reader that sees an odd or changed version restarts its search
+ * - Erased towers are freed once every reader pinned before the erase has finished
+ *   (epoch-based reclamation, run by the writer)
+ *
+ * Thread-safety:
+ * - All member functions except construction and destruction may be called concurrently;
+ *   writers are serialized, readers only wait for writers by retrying
+ * - Iterators pin the calling thread's epoch; they must be used and destroyed on the
+ *   thread that created them and should not be held for long, as they keep erased
+ *   towers alive
+ * - Iteration is weakly consistent like ConcurrentSkipList
+ * - size() is exact only when no write is in flight
+ *
+ * Author: Ilya Pavlov (st129535@student.spbu.ru)
+ *
+ * SingleWriterSkipList Invariants:
+ * 1. Towers reachable from head on each level form a sorted linked list ending at nullptr
+ * 2. A tower's version is even unless a writer is changing its forward pointers or the
+ *    tower has been erased
+ * 3. An erased tower is freed only after every reader that pinned an epoch up to the
+ *    one of its erase has unpinned
+ */
+#ifndef SINGLE_WRITER_SKIPLIST_H
+#define SINGLE_WRITER_SKIPLIST_H
+
+#include "SkipList.h"
+#include "ConcurrentSkipList.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+template<typename T>
+class alignas(std::atomic<void*>) SingleWriterSkipNode
+{
+public:
+    T data;                                 // The data stored in this tower
+    int height = 1;                         // Number of levels this tower is linked into
+    std::atomic<std::uint32_t> version{0};  // Seqlock over the forward pointers
+
+    template <typename... Args>
+    explicit SingleWriterSkipNode(int h, Args&&... args) : data(std::forward<Args>(args)...), height(h) {}
+    ~SingleWriterSkipNode() = default;
+
+    // Forward pointers are stored inline after the node
+    std::atomic<SingleWriterSkipNode*>* forward() noexcept { return reinterpret_cast<std::atomic<SingleWriterSkipNode*>*>(this + 1); }
+    std::atomic<SingleWriterSkipNode*>& next(int level) noexcept { return forward()[level - 1]; }
+};
+
+// Allocation unit for single-writer towers
+template<typename T>
+struct alignas(SingleWriterSkipNode<T>) SingleWriterSkipNodeWord
+{
+    unsigned char bytes[alignof(SingleWriterSkipNode<T>)];
+};
+
+template<typename T, typename Compare = std::less<>, typename Allocator = std::allocator<T>>
+class SingleWriterSkipList
+{
+    using Node = SingleWriterSkipNode<T>;
+    struct ReaderRecord;
+
+    // Keeps the calling thread's epoch pinned while alive (re-entrant)
+    class Guard
+    {
+    public:
+        Guard() = default;
+        explicit Guard(const SingleWriterSkipList* owner) : list(owner), record(owner->localRecord()) { list->pin(record); }
+        Guard(const Guard& other) : list(other.list), record(other.record) { if (record) list->pin(record); }
+        Guard(Guard&& other) noexcept : list(other.list), record(std::exchange(other.record, nullptr)) {}
+        Guard& operator=(Guard other) noexcept
+        {
+            std::swap(list, other.list);
+            std::swap(record, other.record);
+            return *this;
+        }
+        ~Guard() { if (record) list->unpin(record); }
+
+        ReaderRecord* reader_record() const noexcept { return record; }
+
+    private:
+        const SingleWriterSkipList* list = nullptr;
+        ReaderRecord* record = nullptr;
+    };
+
+public:
+    static constexpr int MAX_LVL = 32;
+
+    // Iterators are read-only and weakly consistent
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = const T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return current->data; }
+        pointer operator->() const { return &current->data; }
+
+        // A tower changed or erased under the iterator is left by a new search for
+        // the first element after it
+        const_iterator& operator++()
+        {
+            if (current)
+            {
+                Node* next_node;
+                if (!list->readLink(current, 1, next_node))
+                {
+                    next_node = list->searchNode(&current->data, true, guard.reader_record());
+                }
+                current = next_node;
+            }
+            if (!current) guard = Guard();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const { return current == other.current; }
+        bool operator!=(const const_iterator& other) const { return current != other.current; }
+
+    private:
+        friend class SingleWriterSkipList;
+        const_iterator(const SingleWriterSkipList* owner, Node* node, Guard&& pin)
+            : list(owner), current(node), guard(node ? std::move(pin) : Guard()) {}
+        const SingleWriterSkipList* list = nullptr;
+        Node* current = nullptr;
+        Guard guard;
+    };
+    using iterator = const_iterator;
+
+    //types initialization
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<SingleWriterSkipNodeWord<T>>;
+    using allocator_type = Allocator;
+
+    // Constructor and destructor
+    explicit SingleWriterSkipList(const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : _alloc(alloc),
+          _node_alloc(alloc),
+          _comp(comp),
+          _uid(ConcurrentSkipListIds::next())
+    {
+        head = create_node(MAX_LVL);
+    }
+    SingleWriterSkipList(const SingleWriterSkipList&) = delete;
+    SingleWriterSkipList& operator=(const SingleWriterSkipList&) = delete;
+    // Destructor, must not run concurrently with any other member function
+    ~SingleWriterSkipList()
+    {
+        Node* node = head;
+        while (node)
+        {
+            Node* next_node = node->next(1).load(std::memory_order_relaxed);
+            delete_node(node);
+            node = next_node;
+        }
+        for (auto& [epoch, retired] : limbo) delete_node(retired);
+        ReaderRecord* record = records.load(std::memory_order_acquire);
+        while (record)
+        {
+            ReaderRecord* next_record = record->next;
+            delete record;
+            record = next_record;
+        }
+    }
+
+    Allocator get_allocator() const { return _alloc; }
+    Compare key_comp() const { return _comp; }
+
+    // Iterator access methods
+    const_iterator begin() const
+    {
+        Guard guard(this);
+        Node* first = searchNode(nullptr, false, guard.reader_record());
+        return const_iterator(this, first, std::move(guard));
+    }
+    const_iterator end() const noexcept { return const_iterator(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Number of elements (exact when no write is in flight)
+    size_t size() const noexcept { return _size.load(std::memory_order_relaxed); }
+    bool empty() const noexcept { return head->next(1).load(std::memory_order_acquire) == nullptr; }
+
+    // Insert element
+    /*
+     * The writer finds the predecessors with plain loads (no other thread writes
+     * links), fills the forward pointers of the new tower and then links it bottom-up,
+     * each link stored inside the seqlock window of its predecessor. A reader sees the
+     * tower on a level only once all its forward pointers are in place.
+     */
+    std::pair<iterator, bool> insert(const T& value) { return insertUnique(value, value); }
+    std::pair<iterator, bool> insert(T&& value) { return insertUnique(value, std::move(value)); }
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        T value(std::forward<Args>(args)...);
+        return insertUnique(value, std::move(value));
+    }
+    // Range insert
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first) insert(*first);
+    }
+
+    // Erase by value
+    /*
+     * The tower's version is made odd for good, so readers standing on it restart,
+     * then it is unlinked top-down and retired at the current epoch.
+     */
+    template <typename K>
+    bool erase(const K& key)
+    {
+        std::lock_guard lock(_writer);
+        search_path preds;
+        Node* victim = writerPredecessors(key, preds.data());
+        if (!victim || _comp(key, victim->data)) return false;
+        victim->version.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int l = victim->height; l >= 1; --l)
+        {
+            publish(preds[l], l, victim->next(l).load(std::memory_order_relaxed));
+        }
+        _size.fetch_sub(1, std::memory_order_relaxed);
+        retire(victim);
+        return true;
+    }
+    // Erase all elements
+    void clear()
+    {
+        std::lock_guard lock(_writer);
+        search_path preds;
+        for (Node* victim = head->next(1).load(std::memory_order_relaxed); victim;
+             victim = head->next(1).load(std::memory_order_relaxed))
+        {
+            preds.fill(head);
+            victim->version.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (int l = victim->height; l >= 1; --l)
+            {
+                publish(head, l, victim->next(l).load(std::memory_order_relaxed));
+            }
+            _size.fetch_sub(1, std::memory_order_relaxed);
+            retire(victim);
+        }
+    }
+
+    // Find element, without locks
+    template <typename K>
+    const_iterator find(const K& key) const
+    {
+        Guard guard(this);
+        Node* node = searchNode(&key, false, guard.reader_record());
+        if (node && !_comp(key, node->data)) return const_iterator(this, node, std::move(guard));
+        return end();
+    }
+    // Check for existence
+    template <typename K>
+    bool contains(const K& key) const
+    {
+        Guard guard(this);
+        Node* node = searchNode(&key, false, guard.reader_record());
+        return node && !_comp(key, node->data);
+    }
+    // First not less than key
+    template <typename K>
+    const_iterator lower_bound(const K& key) const
+    {
+        Guard guard(this);
+        Node* node = searchNode(&key, false, guard.reader_record());
+        return const_iterator(this, node, std::move(guard));
+    }
+    // First greater than key
+    template <typename K>
+    const_iterator upper_bound(const K& key) const
+    {
+        Guard guard(this);
+        Node* node = searchNode(&key, true, guard.reader_record());
+        return const_iterator(this, node, std::move(guard));
+    }
+
+    // Searches restarted after meeting a concurrent write, summed over reader threads
+    size_t read_retries() const noexcept
+    {
+        size_t total = 0;
+        for (ReaderRecord* record = records.load(std::memory_order_acquire); record; record = record->next)
+        {
+            total += record->retries.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+    // Erased towers still waiting for readers
+    size_t retained() const
+    {
+        std::lock_guard lock(_writer);
+        return limbo.size();
+    }
+
+    // Check if container is correct, must not run concurrently with modifications
+    bool validate() const
+    {
+        size_t count = 0;
+        for (int l = 1; l <= MAX_LVL; ++l)
+        {
+            Node* prev = nullptr;
+            for (Node* node = head->next(l).load(); node; node = node->next(l).load())
+            {
+                if (node->version.load() & 1) return false;
+                if (node->height < l) return false;
+                if (prev && !_comp(prev->data, node->data)) return false;
+                if (l == 1) ++count;
+                prev = node;
+            }
+        }
+        return count == size();
+    }
+
+private:
+    using search_path = std::array<Node*, MAX_LVL + 1>;
+
+    // Per-thread reclamation state, registered with the list on first read; kept on
+    // its own cache line so readers never share one
+    struct alignas(64) ReaderRecord
+    {
+        std::atomic<std::uint64_t> epoch{0};    // (global epoch << 1) | 1 while pinned, 0 otherwise
+        std::atomic<size_t> retries{0};
+        std::thread::id owner;
+        ReaderRecord* next = nullptr;
+        int nest = 0;                           // Guards alive on this thread
+    };
+
+    static constexpr size_t COLLECT_EVERY = 64;  // retirements between reclamation passes
+
+    Allocator _alloc;
+    mutable node_allocator _node_alloc;
+    Compare _comp;
+    Node* head;
+    std::atomic<int> top_level{1};
+    std::atomic<size_t> _size{0};
+    mutable std::atomic<ReaderRecord*> records{nullptr};
+    std::atomic<std::uint64_t> global_epoch{1};
+    std::uint64_t _uid;
+    // Writer state: serializes writers and owns the level generator and the retired towers
+    mutable std::mutex _writer;
+    SkipLevelGenerator _level_gen;
+    std::vector<std::pair<std::uint64_t, Node*>> limbo;
+
+    // Number of allocation units occupied by a tower of the given height
+    static constexpr size_t node_units(int height) noexcept
+    {
+        return (sizeof(Node) + height * sizeof(std::atomic<Node*>) + sizeof(SingleWriterSkipNodeWord<T>) - 1) / sizeof(SingleWriterSkipNodeWord<T>);
+    }
+    // Creates a new tower of given height
+    template <typename... Args>
+    Node* create_node(int height, Args&&... args) const
+    {
+        SingleWriterSkipNodeWord<T>* raw = std::allocator_traits<node_allocator>::allocate(_node_alloc, node_units(height));
+        Node* node = reinterpret_cast<Node*>(raw);
+        try
+        {
+            std::allocator_traits<node_allocator>::construct(_node_alloc, node, height, std::forward<Args>(args)...);
+        }catch(...)
+        {
+            std::allocator_traits<node_allocator>::deallocate(_node_alloc, raw, node_units(height));
+            throw;
+        }
+        for (int l = 1; l <= height; ++l)
+        {
+            std::construct_at(&node->next(l), nullptr);
+        }
+        return node;
+    }
+    // Properly deallocates a tower using the allocator
+    void delete_node(Node* node) const noexcept
+    {
+        size_t units = node_units(node->height);
+        std::allocator_traits<node_allocator>::destroy(_node_alloc, node);
+        std::allocator_traits<node_allocator>::deallocate(_node_alloc, reinterpret_cast<SingleWriterSkipNodeWord<T>*>(node), units);
+    }
+
+    // Seqlock read of node->next(level): false if a writer was changing the node or has
+    // erased it, in which case the caller restarts
+    bool readLink(Node* node, int level, Node*& link) const noexcept
+    {
+        std::uint32_t before = node->version.load(std::memory_order_acquire);
+        if (before & 1) return false;
+        link = node->next(level).load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return node->version.load(std::memory_order_relaxed) == before;
+    }
+    // Seqlock write of node->next(level), writer only
+    void publish(Node* node, int level, Node* link) noexcept
+    {
+        std::uint32_t version = node->version.load(std::memory_order_relaxed);
+        node->version.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        node->next(level).store(link, std::memory_order_release);
+        node->version.store(version + 2, std::memory_order_release);
+    }
+    // Lock-free search for the first tower not less than *key (greater if strict; the
+    // first tower if key is nullptr), restarting from head after a failed seqlock read
+    template <typename K>
+    Node* searchNode(const K* key, bool strict, ReaderRecord* record) const
+    {
+        auto before = [&](const Node* node) { return key && (strict ? !_comp(*key, node->data) : _comp(node->data, *key)); };
+        while (true)
+        {
+            Node* pred = head;
+            Node* curr = nullptr;
+            bool consistent = true;
+            for (int l = top_level.load(std::memory_order_acquire); l >= 1 && consistent; --l)
+            {
+                while ((consistent = readLink(pred, l, curr)) && curr && before(curr))
+                {
+                    pred = curr;
+                }
+            }
+            if (consistent) return curr;
+            record->retries.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    Node* searchNode(std::nullptr_t, bool strict, ReaderRecord* record) const
+    {
+        return searchNode(static_cast<const T*>(nullptr), strict, record);
+    }
+    // Writer-side search: fills preds on every level and returns the first tower not
+    // less than key; the writer lock must be held
+    template <typename K>
+    Node* writerPredecessors(const K& key, Node** preds) const
+    {
+        Node* pred = head;
+        for (int l = MAX_LVL; l >= 1; --l)
+        {
+            Node* curr = pred->next(l).load(std::memory_order_relaxed);
+            while (curr && _comp(curr->data, key))
+            {
+                pred = curr;
+                curr = pred->next(l).load(std::memory_order_relaxed);
+            }
+            preds[l] = pred;
+        }
+        return pred->next(1).load(std::memory_order_relaxed);
+    }
+    // Shared insert path: search by key, build the tower from args only if absent
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> insertUnique(const K& key, Args&&... args)
+    {
+        Guard guard(this);
+        std::lock_guard lock(_writer);
+        search_path preds;
+        Node* successor = writerPredecessors(key, preds.data());
+        if (successor && !_comp(key, successor->data))
+        {
+            return {const_iterator(this, successor, std::move(guard)), false};
+        }
+        int height = _level_gen(MAX_LVL);
+        Node* node = create_node(height, std::forward<Args>(args)...);
+        for (int l = 1; l <= height; ++l)
+        {
+            node->next(l).store(preds[l]->next(l).load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        if (height > top_level.load(std::memory_order_relaxed))
+        {
+            top_level.store(height, std::memory_order_release);
+        }
+        for (int l = 1; l <= height; ++l)
+        {
+            publish(preds[l], l, node);
+        }
+        _size.fetch_add(1, std::memory_order_relaxed);
+        return {const_iterator(this, node, std::move(guard)), true};
+    }
+
+    // Epoch-based reclamation
+    /*
+     * A tower unlinked before the global epoch moved past E can only be reached by
+     * readers pinned at E or earlier; it is freed once no reader is pinned that early.
+     */
+    ReaderRecord* localRecord() const
+    {
+        struct Cache
+        {
+            std::uint64_t list = 0;
+            ReaderRecord* record = nullptr;
+        };
+        thread_local Cache cache;
+        if (cache.list == _uid) return cache.record;
+
+        std::thread::id self = std::this_thread::get_id();
+        ReaderRecord* record = records.load(std::memory_order_acquire);
+        while (record && record->owner != self) record = record->next;
+        if (!record)
+        {
+            record = new ReaderRecord;
+            record->owner = self;
+            record->next = records.load(std::memory_order_relaxed);
+            while (!records.compare_exchange_weak(record->next, record, std::memory_order_release, std::memory_order_relaxed)) {}
+        }
+        cache = {_uid, record};
+        return record;
+    }
+    void pin(ReaderRecord* record) const
+    {
+        if (record->nest++ > 0) return;
+        std::uint64_t epoch = global_epoch.load();
+        while (true)
+        {
+            record->epoch.store((epoch << 1) | 1);
+            std::uint64_t now = global_epoch.load();
+            if (now == epoch) break;
+            epoch = now;
+        }
+    }
+    void unpin(ReaderRecord* record) const noexcept
+    {
+        if (--record->nest == 0) record->epoch.store(0, std::memory_order_release);
+    }
+    // Queues an unlinked tower; the writer lock must be held
+    void retire(Node* node)
+    {
+        limbo.emplace_back(global_epoch.fetch_add(1), node);
+        if (limbo.size() % COLLECT_EVERY == 0) collect();
+    }
+    // Frees the retired towers no pinned reader can still reach
+    void collect() noexcept
+    {
+        std::uint64_t oldest = global_epoch.load();
+        for (ReaderRecord* record = records.load(std::memory_order_acquire); record; record = record->next)
+        {
+            std::uint64_t local = record->epoch.load();
+            if ((local & 1) && (local >> 1) < oldest) oldest = local >> 1;
+        }
+        std::erase_if(limbo, [&](const std::pair<std::uint64_t, Node*>& entry)
+        {
+            if (entry.first < oldest)
+            {
+                delete_node(entry.second);
+                return true;
+            }
+            return false;
+        });
+    }
+};
+
+#endif
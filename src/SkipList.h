@@ -6,56 +6,315 @@
  * - Customizable comparator and allocator
  * - O(log n) average time complexity for search, insert, and delete
  * - Supports move semantics and copy operations
- * - Thread-safe random number generation for level determination
- * - Comprehensive validation and debugging utilities
+ * - Per-instance level generator with configurable promotion probability and seeding
+ * - Optional indexable mode (span widths on every link): nth, rank, count_range in O(log n)
+ * - Finger search: hinted lookups and an optional finger on the last search path,
+ *   O(log d) for a key d elements away
+ * - Equivalent keys kept in insertion order for comparators declaring equivalent_keys
+ *   (the multimap mode of SkipMap.h)
+ * - Validation and debugging utilities, with hot-path checks behind SKIPLIST_DEBUG_CHECKS
+ * - Shape and hot-path statistics (stats()), counters collected behind SKIPLIST_STATS
+ * - Parallel sorted build, for_each and set algebra on std::thread (parallel_t)
+ * - Lazy range views (range(lo, hi), equal_range) over the bottom level
+ * - Compact binary save/load (varint deltas for integer keys, optional tower heights)
+ * - Persistent lists through allocators that keep a SkipListRoot (see SkipListMmap.h)
  * 
  * Author: Ilya Pavlov (st129535@student.spbu.ru)
  
  * SkipList Invariants:
- * 1. Each level is a sorted linked list
+ * 1. Each level is a sorted linked list (strictly, unless the comparator allows equivalent keys)
  * 2. Higher levels are subsets of lower levels
- * 3. Head and tail nodes exist at each level
- * 4. All nodes have proper left/right/down pointers
+ * 3. Head and tail sentinels terminate every level
+ * 4. Every element is a single tower linked into levels 1..height
  * 5. Size matches number of elements at bottom level
- * 6. Empty levels above level 1 are removed
+ * 6. current_max_level is the highest non-empty level (at least 1)
+ * 7. Indexable lists: width(l) of a tower is the number of bottom-level steps to
+ *    next(l), on every level up to MAX_LVL (head included)
  */
 #ifndef SKIPLIST_H
 #define SKIPLIST_H
 
 #include <vector>
+#include <array>
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <functional>
 #include <utility>
 #include <random>
+#include <stdexcept>
+#include <bit>
+#include <cstdint>
+#include <cmath>
+#include <type_traits>
+#include <iterator>
+#include <ostream>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <ranges>
+#include <limits>
+#include <thread>
+#include <exception>
+#include <atomic>
+
+// Structural self-checks (validate() after erase, iterator ownership checks).
+// Enabled for test builds with -DSKIPLIST_DEBUG_CHECKS, compiled out otherwise.
+#ifndef SKIPLIST_DEBUG_CHECKS
+#define SKIPLIST_DEBUG_CHECKS 0
+#endif
+// Hot-path counters reported by stats() (searches, comparisons, allocations, level changes).
+// Collected with -DSKIPLIST_STATS, compiled out otherwise.
+#ifndef SKIPLIST_STATS
+#define SKIPLIST_STATS 0
+#endif
 
 template<typename T>
 class SkipNode
 {
 public:
-    T data;                     // The data stored in this node
-    SkipNode* left = nullptr;   // Pointer to the previous node at the same level
-    SkipNode* right = nullptr;  // Pointer to the next node at the same level
-    SkipNode* down = nullptr;   // Pointer to the same node at the level below
-    
-    // Default constructor creates a node with default-constructed data
-    SkipNode() : data(T()), left(nullptr), right(nullptr), down(nullptr) {};
-    // Constructor with data initialization
-    SkipNode(const T& indata) : data(indata), left(nullptr), right(nullptr), down(nullptr) {}
+    T data;                     // The data stored in this tower (shared by all its levels)
+    SkipNode* left = nullptr;   // Pointer to the previous tower at the bottom level
+    int height = 1;             // Number of levels this tower is linked into
+
+    // Constructs the data in place from args (sentinels use default-constructed data)
+    template <typename... Args>
+    explicit SkipNode(int h, Args&&... args) : data(std::forward<Args>(args)...), left(nullptr), height(h) {}
     // Default destructor - memory management handled by SkipList
     ~SkipNode() = default;
+
+    // Forward pointers are stored inline, right after the node itself (one per level)
+    SkipNode** forward() noexcept { return reinterpret_cast<SkipNode**>(this + 1); }
+    SkipNode* const* forward() const noexcept { return reinterpret_cast<SkipNode* const*>(this + 1); }
+    // Pointer to the next tower at the given level (levels are numbered from 1)
+    SkipNode*& next(int level) noexcept { return forward()[level - 1]; }
+    SkipNode* next(int level) const noexcept { return forward()[level - 1]; }
+    // Span widths follow the forward pointers in indexable lists (one per level)
+    size_t& width(int level) noexcept { return reinterpret_cast<size_t*>(forward() + height)[level - 1]; }
+    size_t width(int level) const noexcept { return reinterpret_cast<const size_t*>(forward() + height)[level - 1]; }
+};
+
+// Allocation unit for towers: a tower of height h occupies enough units to hold
+// the node followed by h forward pointers
+template<typename T>
+struct alignas(SkipNode<T>) SkipNodeWord
+{
+    unsigned char bytes[alignof(SkipNode<T>)];
+};
+
+// Tower height generator: a per-instance splitmix64 stream with one draw per insert
+/*
+ * For p = 1/2^k the level is taken from the trailing zero count of one 64-bit draw.
+ * Any other p (e.g. 1/e) compares 16-bit slices of the draw against p * 2^16.
+ * Seeding with a fixed value gives reproducible structures for benchmarks.
+ */
+class SkipLevelGenerator
+{
+public:
+    static constexpr double HALF = 0.5;
+    static constexpr double QUARTER = 0.25;
+    static constexpr double INV_E = 0.36787944117144233;
+
+    explicit SkipLevelGenerator(double p = HALF) : SkipLevelGenerator(p, fresh_seed()) {}
+    SkipLevelGenerator(double p, std::uint64_t seed_value)
+    {
+        if (!(p > 0.0 && p < 1.0))
+        {
+            throw std::invalid_argument("Promotion probability must be in (0, 1)");
+        }
+        probability = p;
+        for (int k = 1; k <= 16; ++k)
+        {
+            if (p == std::ldexp(1.0, -k)) shift = k;
+        }
+        threshold = static_cast<std::uint32_t>(std::lround(p * 65536.0));
+        seed(seed_value);
+    }
+
+    void seed(std::uint64_t seed_value) noexcept { state = seed_value; }
+    double promotion_probability() const noexcept { return probability; }
+    // Independent stream with the same probability, seeded from this one, for
+    // drawing levels on several threads
+    SkipLevelGenerator split() noexcept
+    {
+        SkipLevelGenerator child = *this;
+        child.seed(next());
+        return child;
+    }
+
+    // Draws a level in [1, max_level]
+    int operator()(int max_level) noexcept
+    {
+        std::uint64_t bits = next();
+        int level = 1;
+        if (shift)
+        {
+            level += std::countr_zero(bits | (std::uint64_t(1) << 63)) / shift;
+            return level < max_level ? level : max_level;
+        }
+        for (int used = 0; level < max_level; ++level, used += 16)
+        {
+            if (used == 64)
+            {
+                bits = next();
+                used = 0;
+            }
+            if (((bits >> used) & 0xFFFF) >= threshold) break;
+        }
+        return level;
+    }
+
+private:
+    std::uint64_t state = 0;
+    double probability = HALF;
+    int shift = 0;               // k when probability == 1/2^k, 0 otherwise
+    std::uint32_t threshold = 0; // probability scaled to 16 bits
+
+    std::uint64_t next() noexcept
+    {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    // Distinct seed per instance: a thread-local sequence seeded once from random_device
+    static std::uint64_t fresh_seed()
+    {
+        thread_local std::uint64_t sequence = (std::uint64_t(std::random_device{}()) << 32) ^ std::random_device{}();
+        return sequence += 0x9E3779B97F4A7C15ULL;
+    }
+};
+
+// Tag for constructors taking input that is already sorted and free of duplicates
+struct sorted_unique_t
+{
+    explicit sorted_unique_t() = default;
+};
+inline constexpr sorted_unique_t sorted_unique{};
+
+// Policy of the parallel overloads (assign_sorted, for_each, set algebra); threads == 0
+// means one per hardware thread. Work is split into chunks of at least a few thousand
+// elements, so small inputs stay on the calling thread
+struct parallel_t
+{
+    unsigned threads = 0;
+};
+inline constexpr parallel_t parallel{};
+
+// Which element stays in the target of SkipList::merge when both lists hold equivalent keys;
+// the other one is left in the source list
+enum class merge_policy
+{
+    keep_existing,
+    replace_existing
+};
+
+// Encoding choices of SkipList::save; load reads them back from the stream
+struct save_options
+{
+    bool varint_keys = true;     // integer keys as varints of the difference to the previous key
+    bool tower_heights = false;  // store tower heights so load rebuilds the same structure
+};
+
+// State of a list kept by a persistent allocator next to its towers (see SkipListMmap.h)
+struct SkipListRoot
+{
+    void* head = nullptr;         // sentinels of the saved list, nullptr if none was saved
+    void* tail = nullptr;
+    size_t size = 0;
+    int current_max_level = 1;
+    int max_level = 0;
+    std::uint64_t layout = 0;     // element and tower sizes, checked when the list is adopted
+    bool attached = false;        // a SkipList currently owns the saved list
+    std::int64_t relocation = 0;  // added to every saved link, if the towers were mapped elsewhere
+    bool recover = false;         // the list was left open by a process that died
+};
+
+// Snapshot returned by SkipList::stats()
+struct SkipListStats
+{
+    // Shape, computed from the towers when the snapshot is taken
+    size_t size = 0;
+    int current_max_level = 0;
+    int max_level = 0;
+    double promotion_probability = 0;
+    std::vector<size_t> level_histogram;  // towers per height, index 0 unused
+    size_t bytes_in_use = 0;              // towers and sentinels, allocation units included
+    double expected_path_length = 0;      // mean links a descent from head follows to reach an element
+
+    // Hot-path counters since construction or reset_stats() (zero without SKIPLIST_STATS)
+    size_t searches = 0;         // descents by key from head (find, bounds, insert, erase)
+    size_t search_steps = 0;     // links followed by those descents
+    size_t comparisons = 0;      // comparator calls made by those descents
+    size_t nodes_allocated = 0;  // towers built by create_node, sentinels included
+    size_t bytes_allocated = 0;
+    size_t nodes_freed = 0;
+    size_t bytes_freed = 0;
+    size_t level_growths = 0;    // inserts that raised current_max_level
+    size_t level_trims = 0;      // levels dropped because they became empty
+
+    double average_path_length() const noexcept
+    {
+        return searches ? static_cast<double>(search_steps) / searches : 0.0;
+    }
+    double comparisons_per_search() const noexcept
+    {
+        return searches ? static_cast<double>(comparisons) / searches : 0.0;
+    }
+    // Writes the snapshot as one line of JSON
+    void write_json(std::ostream& os) const
+    {
+        os << "{\"size\":" << size << ",\"current_max_level\":" << current_max_level
+           << ",\"max_level\":" << max_level << ",\"promotion_probability\":" << promotion_probability
+           << ",\"expected_path_length\":" << expected_path_length << ",\"level_histogram\":[";
+        for (size_t h = 1; h < level_histogram.size(); ++h)
+        {
+            os << (h > 1 ? "," : "") << level_histogram[h];
+        }
+        os << "],\"bytes_in_use\":" << bytes_in_use << ",\"searches\":" << searches
+           << ",\"search_steps\":" << search_steps << ",\"comparisons\":" << comparisons
+           << ",\"average_path_length\":" << average_path_length()
+           << ",\"comparisons_per_search\":" << comparisons_per_search()
+           << ",\"nodes_allocated\":" << nodes_allocated << ",\"bytes_allocated\":" << bytes_allocated
+           << ",\"nodes_freed\":" << nodes_freed << ",\"bytes_freed\":" << bytes_freed
+           << ",\"level_growths\":" << level_growths << ",\"level_trims\":" << level_trims << "}\n";
+    }
+};
+
+// One level of the path a descent by key takes (see SkipList::search_path)
+template<typename T>
+struct SkipListPathLevel
+{
+    int level = 0;
+    size_t steps = 0;                // links followed on this level
+    const T* predecessor = nullptr;  // element the descent drops down from, nullptr for head
+    const T* next = nullptr;         // first element of the level not less than the key, nullptr for tail
 };
 
-template<typename T,typename Compare = std::less<>, typename Allocator = std::allocator<T>>
+// Tower height cap of SkipList when none is given: about 2^32 elements at p = 1/2
+inline constexpr int skiplist_default_max_level = 32;
+// Smallest tower height cap that keeps searches logarithmic for up to capacity
+// elements at p = 1/2 (one level per doubling, at least 2)
+constexpr int skiplist_levels_for(std::size_t capacity) noexcept
+{
+    int levels = 2;
+    while (levels < 64 && (std::size_t{1} << levels) < capacity) ++levels;
+    return levels;
+}
+
+template<typename T,typename Compare = std::less<>, typename Allocator = std::allocator<T>, bool Indexable = false,
+         int MaxLevel = skiplist_default_max_level>
 class SkipList
 {
+    static_assert(MaxLevel >= 1 && MaxLevel <= 64, "MaxLevel must be in [1, 64]");
 public:
     // Iterator types for STL compatibility
+    class const_iterator;
     // iterators 
     class iterator
     {
     public:
-        using iterator_category = std::forward_iterator_tag;
+        using iterator_category = std::bidirectional_iterator_tag;
         using value_type = T;
         using difference_type = std::ptrdiff_t;
         using pointer = T*;
@@ -70,7 +329,7 @@ public:
         {
             if (current)
             {
-                current = current->right;
+                current = current->next(1);
             }
             return *this;
         }
@@ -81,31 +340,63 @@ public:
             ++(*this);
             return tmp;
         }
+        // Steps back along the bottom level; --end() is the last element
+        iterator& operator--()
+        {
+            if (current)
+            {
+                current = current->left;
+            }
+            return *this;
+        }
+
+        iterator operator--(int)
+        {
+            iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
 
         bool operator==(const iterator& other) const { return current == other.current; }
         bool operator!=(const iterator& other) const { return current != other.current; }
         
     private:
+        friend class SkipList;
+        friend class const_iterator;
+        iterator(SkipNode<T>* node, const SkipNode<T>* list_tail) : current(node) { setOwner(list_tail); }
         SkipNode<T>* current;
+#if SKIPLIST_DEBUG_CHECKS
+        // Tail sentinel of the owning list; it follows the nodes through move and swap
+        const SkipNode<T>* owner = nullptr;
+        void setOwner(const SkipNode<T>* list_tail) { owner = list_tail; }
+#else
+        void setOwner(const SkipNode<T>*) {}
+#endif
     };
     // const_iterators
     class const_iterator
     {
     public:
-        using iterator_category = std::forward_iterator_tag;
-        using value_type = const T;
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
         using difference_type = std::ptrdiff_t;
         using pointer = const T*;
         using reference = const T&;
 
         const_iterator(const SkipNode<T>* node = nullptr) : current(node) {}
+        const_iterator(const iterator& it) : current(it.current)
+        {
+#if SKIPLIST_DEBUG_CHECKS
+            owner = it.owner;
+#endif
+        }
 
         reference operator*() const { return current->data; }
         pointer operator->() const { return &current->data; }
 
         const_iterator& operator++()
         {
-            if (current) current = current->right;
+            if (current) current = current->next(1);
             return *this;
         }
 
@@ -116,11 +407,68 @@ public:
             return tmp;
         }
 
+        const_iterator& operator--()
+        {
+            if (current) current = current->left;
+            return *this;
+        }
+
+        const_iterator operator--(int)
+        {
+            const_iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
         bool operator==(const const_iterator& other) const { return current == other.current; }
         bool operator!=(const const_iterator& other) const { return current != other.current; }
         
     private:
+        friend class SkipList;
+        const_iterator(const SkipNode<T>* node, const SkipNode<T>* list_tail) : current(node) { setOwner(list_tail); }
         const SkipNode<T>* current;
+#if SKIPLIST_DEBUG_CHECKS
+        const SkipNode<T>* owner = nullptr;
+        void setOwner(const SkipNode<T>* list_tail) { owner = list_tail; }
+#else
+        void setOwner(const SkipNode<T>*) {}
+#endif
+    };
+    // Lazy view of the elements in [lo, hi) returned by range()
+    /*
+     * begin() is the lower bound of lo, found by one search when the view is made.
+     * The end is a sentinel: an iterator reaches it at the tail or at the first
+     * element not less than hi, one comparison per test, so nothing is searched or
+     * copied up front and take/filter/transform compose without materializing.
+     * Sentinels refer to the view's copy of hi and are valid while the view is.
+     */
+    template <typename Iter, typename K>
+    class range_view : public std::ranges::view_interface<range_view<Iter, K>>
+    {
+    public:
+        class sentinel
+        {
+        public:
+            sentinel() = default;
+            friend bool operator==(const Iter& it, const sentinel& last) { return last.reached(it); }
+
+        private:
+            friend class range_view;
+            sentinel(const SkipList* list, const K* hi) : list(list), hi(hi) {}
+            bool reached(const Iter& it) const { return it.current == list->tail || !list->_comp(it.current->data, *hi); }
+            const SkipList* list = nullptr;
+            const K* hi = nullptr;
+        };
+
+        Iter begin() const { return first; }
+        sentinel end() const { return sentinel(list, &hi); }
+
+    private:
+        friend class SkipList;
+        range_view(Iter first, const SkipList* list, K hi) : first(first), list(list), hi(std::move(hi)) {}
+        Iter first;
+        const SkipList* list;
+        K hi;
     };
     //types initialization
     using value_type = T;
@@ -132,34 +480,26 @@ public:
     using difference_type = std::ptrdiff_t;
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<SkipNode<T>>;
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<SkipNodeWord<T>>;
     using allocator_type = Allocator;
     // Returns the allocator used by this container
     Allocator get_allocator() const { return _alloc; }
     // Iterator access methods
     iterator begin() noexcept                  // Returns iterator to first element
     {
-        SkipNode<T>* node = head;
-        while (node->down) node = node->down;
-        return iterator(node->right);
+        return iterator(head->next(1), tail);
     };
     iterator end() noexcept                   // Returns iterator to one past last element
     {
-        SkipNode<T>* node = tail;
-        while(node->down) node = node->down;
-        return iterator(node);
+        return iterator(tail, tail);
     };
     const_iterator cbegin() const noexcept    // Const version of begin()
     {
-        const SkipNode<T>* node = head;
-        while (node->down) node = node->down;
-        return const_iterator(node->right); 
+        return const_iterator(head->next(1), tail); 
     };
     const_iterator cend() const noexcept      // Const version of end()
     {
-        const SkipNode<T>* node = tail;
-        while(node->down) node = node->down;
-        return const_iterator(node);
+        return const_iterator(tail, tail);
     };
     // Return const_iterators overload for begin(), end() 
     const_iterator begin() const noexcept { return cbegin(); }
@@ -177,98 +517,135 @@ public:
     explicit SkipList(const Compare& comp = Compare(), const Allocator& alloc = Allocator())
         : _alloc(alloc),
           _node_alloc(alloc),
-          _comp(comp),
-          MAX_LVL(DEFAULT_MAX_LVL)
+          _comp(comp)
     {
-        head = create_node(T());
-        tail = create_node(T());
-        head->right = tail;
-        tail->left = head;
-        head->down = nullptr;
-        tail->down = nullptr;
-
+        openSaved();
+    }
+    // Build from a sorted range of unique keys in linear time (see assign_sorted)
+    template <typename InputIt>
+    SkipList(sorted_unique_t, InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : SkipList(comp, alloc)
+    {
+        assign_sorted(first, last);
+    }
+    // Constructor with an explicit level generator (promotion probability / seed)
+    explicit SkipList(const SkipLevelGenerator& level_gen, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : SkipList(comp, alloc)
+    {
+        _level_gen = level_gen;
     }
     // Copy constructor
+    /*
+     * Towers are cloned in a single sweep over the bottom level of other;
+     * last[l] remembers the most recent tower linked at level l
+     */
     SkipList(const SkipList& other)
         : _alloc(std::allocator_traits<Allocator>::select_on_container_copy_construction(other._alloc)),
           _node_alloc(_alloc),
           _comp(other._comp),
-          current_max_level(other.current_max_level),
-          MAX_LVL(other.MAX_LVL),
-          _size(other._size)
+          _level_gen(other._level_gen),
+          _finger_enabled(other._finger_enabled)
     {
-        std::vector<SkipNode<T>*> heads;
-        std::vector<SkipNode<T>*> tails;
-        
-        for(int lvl = 1; lvl <= current_max_level; ++lvl)
+        initSentinels();
+        predecessor_path last;
+        last.fill(head);
+        try
         {
-            SkipNode<T>* new_head = create_node(T());
-            SkipNode<T>* new_tail = create_node(T());
-            new_head->right = new_tail;            
-            new_tail->left = new_head;
-            
-            if(!heads.empty())
-            {
-                new_head->down = heads.back();
-                new_tail->down = tails.back();
-            }else
+            for (const SkipNode<T>* other_curr = other.head->next(1); other_curr != other.tail; other_curr = other_curr->next(1))
             {
-                new_head->down = nullptr;
-                new_tail->down = nullptr;
+                appendTower(create_node(other_curr->height, other_curr->data), last.data());
             }
-            heads.push_back(new_head);
-            tails.push_back(new_tail);
-        }
-        
-        head = heads.back();
-        tail = tails.back();
-
-        for(int lvl = 1; lvl <= current_max_level; ++lvl)
+        }catch(...)
         {
-            copyLevel(other, lvl);
+            destroyAll();
+            throw;
         }
-        
     };
     // Move constructor
     SkipList(SkipList&& other) noexcept 
-        : _alloc(std::allocator_traits<Allocator>::select_on_container_copy_construction(other._alloc)),
-          _node_alloc(_alloc),
+        : _alloc(other._alloc),
+          _node_alloc(other._node_alloc),
           _comp(std::move(other._comp)),
           head(other.head),
           tail(other.tail),
           current_max_level(other.current_max_level),
-          MAX_LVL(other.MAX_LVL),
-          _size(other._size)
+          _size(other._size),
+          _level_gen(other._level_gen),
+          _finger(other._finger),
+          _finger_valid(other._finger_valid),
+          _finger_enabled(other._finger_enabled)
     {
-        other.head = create_node(T());
-        other.tail = create_node(T());
-        other.head->right = other.tail;
-        other.tail->left = other.head;
+        other.initSentinels();
         other.current_max_level = 1;
         other._size = 0;
     };
     // Destructor
     ~SkipList() noexcept
     {
-        SkipNode<T>* current_level = head;
-        while (current_level != nullptr) {
-            SkipNode<T>* current_node = current_level;
-            current_level = current_level->down;
-            while (current_node != nullptr) {
-                SkipNode<T>* next_node = current_node->right;
-                delete_node(current_node);
-                current_node = next_node;
-            }
-        }
+        destroyAll();
     }
     // Operator = for copy construction
-    SkipList& operator=(SkipList& other) noexcept
+    /*
+     * Existing towers are reused in order: each keeps its height, receives the
+     * next value of other by assignment and is appended again in one sweep.
+     * Missing towers are allocated, leftover ones are freed.
+     */
+    SkipList& operator=(const SkipList& other)
     {
-        if (this != &other)
+        if (this == &other) return *this;
+        if constexpr (std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value)
         {
-            SkipList temp(other);
-            swap(*this, temp);
+            if (!(_alloc == other._alloc))
+            {
+                destroyAll();
+                _alloc = other._alloc;
+                _node_alloc = other._node_alloc;
+                current_max_level = 1;
+                _size = 0;
+                initSentinels();
+            }
+        }
+        _comp = other._comp;
+        _level_gen = other._level_gen;
+        _finger_enabled = other._finger_enabled;
+
+        SkipNode<T>* reuse = head->next(1);
+        resetHead();
+        current_max_level = 1;
+        _size = 0;
+
+        predecessor_path last;
+        last.fill(head);
+        const SkipNode<T>* other_curr = other.head->next(1);
+        try
+        {
+            for (; other_curr != other.tail; other_curr = other_curr->next(1))
+            {
+                SkipNode<T>* node;
+                if (reuse != tail)
+                {
+                    node = reuse;
+                    reuse = reuse->next(1);
+                    try
+                    {
+                        node->data = other_curr->data;
+                    }catch(...)
+                    {
+                        delete_node(node);
+                        throw;
+                    }
+                }else
+                {
+                    node = create_node(other_curr->height, other_curr->data);
+                }
+                appendTower(node, last.data());
+            }
+        }catch(...)
+        {
+            freeChain(reuse);
+            throw;
         }
+        freeChain(reuse);
         return *this;
     }
     // Operator = for move construction
@@ -279,203 +656,474 @@ public:
             SkipList temp(std::move(other));
             swap(*this, temp);
         }
-
-        other.head = create_node(T());
-        other.tail = create_node(T());
-        other.head->right = other.tail;
-        other.tail->left = other.head;
-        other.current_max_level = 1;
+        return *this;
     }
     // Check if empty
     bool empty() const noexcept
     {
-        SkipNode<T>* bottom_head = getHeadAtLevel(1);
-        return bottom_head->right == getTailAtLevel(1);
+        return head->next(1) == tail;
     }
     // Insert element
     /*
      * Insertion Algorithm:
-     * 1. Check for duplicates (return if exists)
-     * 2. Generate random level for new node
-     * 3. Find insertion points at each level (update vector)
-     * 4. Add new levels if needed
-     * 5. Create and link nodes at each level from bottom up
-     * 6. Update size and return iterator to new node
+     * 1. Descend once, recording the last tower before idata at each level (update vector)
+     * 2. If the bottom-level successor equals idata return it (duplicate)
+     * 3. Generate random level for new tower
+     * 4. Raise current_max_level if needed (head already spans MAX_LVL levels)
+     * 5. Create one tower and link it at each level from bottom up
+     * 6. Update size and return iterator to new tower
      */
     std::pair<iterator, bool> insert(const T& idata)
     {
-        if(contains(idata))
+        return insertUnique(idata, idata);
+    }
+    // Insert element (move semantics)
+    std::pair<iterator, bool> insert(T&& idata)
+    {
+        return insertUnique(idata, std::move(idata));
+    }
+    // Insert with a position hint
+    /*
+     * If idata belongs right before hint, its predecessors are found by walking
+     * left from the hint along the bottom level until a tall enough tower shows up,
+     * which costs two comparisons and O(levels) pointer steps. Appending with
+     * hint == end() is the common case. Otherwise falls back to insert(idata).
+     */
+    iterator insert(const_iterator hint, const T& idata)
+    {
+        return insertHint(hint, idata, idata);
+    }
+    iterator insert(const_iterator hint, T&& idata)
+    {
+        return insertHint(hint, idata, std::move(idata));
+    }
+    // Range insert
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        if(first == last) return;
+        for (; first != last; ++first)
         {
-            return {iterator(findNode(idata)), false};
+            insert(cend(), *first);
         }
-        int level = random_level();
-        std::vector<SkipNode<T>*> update(MAX_LVL + 1, nullptr);
-        
-        SkipNode<T>* current_node = head;
-
-        for (int l = current_max_level; l >= 1; --l)
+    }
+    // Replace the contents with a sorted range of unique keys in linear time
+    /*
+     * Towers are appended left to right while last[l] tracks the rightmost tower
+     * of each level. With balanced heights the i-th element gets the height of a
+     * perfectly balanced list; otherwise heights are drawn from the level generator.
+     */
+    template <typename InputIt>
+    void assign_sorted(InputIt first, InputIt last, bool balanced = false)
+    {
+        clear();
+        predecessor_path last_tower;
+        last_tower.fill(head);
+        [[maybe_unused]] const SkipNode<T>* prev = nullptr;
+        for (size_t index = 1; first != last; ++first, ++index)
         {
-                        
-            while(current_node != nullptr && current_node->right != nullptr && current_node->right != getTailAtLevel(l) && _comp(current_node->right->data, idata))
+            if constexpr (debug_checks)
             {
-                current_node = current_node->right;
+                if (prev && (multi ? _comp(*first, prev->data) : !_comp(prev->data, *first)))
+                {
+                    throw std::invalid_argument("assign_sorted: input is not sorted and unique");
+                }
             }
-            update[l] = current_node;
-            current_node = current_node->down;
+            int level = balanced ? balanced_level(index) : random_level();
+            SkipNode<T>* new_node = create_node(level, *first);
+            appendTower(new_node, last_tower.data());
+            prev = new_node;
         }
-
-        if (level > current_max_level)
+    }
+    // Parallel version for random access input
+    /*
+     * The input is cut into one chunk per worker; each worker allocates and links
+     * the towers of its chunk among themselves (levels from its own split() of the
+     * level generator, or balanced heights by global index), then the chunks are
+     * stitched level by level in O(chunks * levels). Allocators that are not
+     * always equal (arenas, files) are not assumed thread-safe and build serially.
+     */
+    template <std::random_access_iterator RandomIt>
+    void assign_sorted(parallel_t policy, RandomIt first, RandomIt last, bool balanced = false)
+    {
+        const size_t n = static_cast<size_t>(last - first);
+        const size_t chunks = parallel_alloc ? workersFor(policy, n) : 1;
+        if (chunks == 1)
         {
-            for (int l = current_max_level + 1; l <= level; ++l)
-            {                
-                SkipNode<T>* new_head = create_node(T());
-                SkipNode<T>* new_tail = create_node(T());
-                
-                if(!new_head || !new_tail)
+            assign_sorted(first, last, balanced);
+            return;
+        }
+        if constexpr (debug_checks)
+        {
+            for (RandomIt it = first; it != last && std::next(it) != last; ++it)
+            {
+                if (multi ? _comp(*std::next(it), *it) : !_comp(*it, *std::next(it)))
                 {
-                    throw std::bad_alloc();
+                    throw std::invalid_argument("assign_sorted: input is not sorted and unique");
                 }
-                
-                new_head->right = new_tail;
-                new_tail->left = new_head;
-                new_head->down = head;
-                new_tail->down = tail;
-                head = new_head;
-                tail = new_tail;
-                update[l] = head;
             }
-            current_max_level = level;
         }
-
-        SkipNode<T>* lower_node = nullptr;
-        for (int l = 1; l <= level; ++l)
+        clear();
+        std::vector<SkipLevelGenerator> gens;
+        for (size_t c = 0; c < chunks; ++c) gens.push_back(_level_gen.split());
+        buildChunks(chunks, [&](size_t c, chunk_chain& chain)
         {
-            
-            SkipNode<T>* new_node = create_node(idata);
-            if (!update[l] || !new_node)
+            const size_t begin = n * c / chunks;
+            const size_t end = n * (c + 1) / chunks;
+            for (size_t i = begin; i < end; ++i)
             {
-                throw std::runtime_error("Invalid insertion state");
-            }
-            new_node->right = update[l]->right;
-            new_node->left = update[l];
-            
-
-            if (update[l]->right) {
-                update[l]->right->left = new_node;
+                int level = balanced ? balanced_level(i + 1) : gens[c](MAX_LVL);
+                chainTower(chain, allocate_node(level, first[i]));
             }
-            update[l]->right = new_node;
-            
-            new_node->down = lower_node;
-            lower_node = new_node;
-            
-
-            if (new_node->left->right != new_node || 
-                (new_node->right && new_node->right->left != new_node)) {
-                std::cerr << "Link corruption detected!" << std::endl;
-                throw std::runtime_error("Pointer corruption during insert");
-            }
-        }
-        ++_size;
-        SkipNode<T>* return_node = findLowerNode(idata, 1);
-        return {iterator(return_node), true};
-    }
-    // Range insert
-    template <typename InputIt>
-    void insert(InputIt first, InputIt last)
-    {
-        if(first == last) return;
-        for (; first != last; ++first)
-        {
-            insert(*first);
-        }
+        });
     }
     //Construct in-place
+    /*
+     * The value is constructed directly inside a new tower, which is freed again
+     * if an equivalent element already exists. Use try_emplace to avoid the
+     * construction when the key is known up front. Lists allowing equivalent keys
+     * keep every element, behind its equivalents.
+     */
     template <typename... Args>
     iterator emplace(Args&&... args)
     {
-        T value(std::forward<Args>(args)...);
-        auto [it, inserted] = insert(std::move(value));
-        return it;
-    }
-    // Merge another SkipList
-    void merge(SkipList&& other)
-    {
-        if(this == &other) return;
-        auto it = other.begin();
-        while(it != other.end())
+        SkipNode<T>* new_node = create_node(random_level(), std::forward<Args>(args)...);
+        predecessor_path update;
+        search_rank rank;
+        if constexpr (multi)
         {
-            if(!contains(*it))
-            {
-                insert(std::move(*it));
-                it = other.erase(it);
-            }else
-            {
-                ++it;
-            }
+            findLastPredecessors(new_node->data, update.data(), rank.data());
+            linkTower(new_node, update.data(), rank.data());
+            return iterator(new_node, tail);
         }
-    }
-    // Erase by value
-    template <typename K>
-    bool erase(const K& value)
-    {
-        SkipNode<T>* node = findNode(value);
-        if (node)
+        SkipNode<T>* successor = findPredecessors(new_node->data, update.data(), rank.data());
+        if (successor != tail && !_comp(new_node->data, successor->data))
         {
-            eraseNode(node);
-            return true;
+            delete_node(new_node);
+            return iterator(successor, tail);
         }
-        return false;
+        linkTower(new_node, update.data(), rank.data());
+        return iterator(new_node, tail);
     }
-    // Erase by iterator
-    iterator erase(iterator pos)
+    // Construct in-place only if no element is equivalent to key
+    /*
+     * Nothing is built when key is already present. The element is constructed
+     * from args, or from key itself when args is empty, and must compare
+     * equivalent to key. key is not read again once args were used, so args may
+     * move from it.
+     */
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args)
     {
-        if (pos == end())
+        if constexpr (sizeof...(Args) == 0)
         {
-            throw std::out_of_range("Cannot erase end() iterator");
-        }
-        if(!validate_iterator(pos))
+            return insertUnique(key, key);
+        }else
         {
-            throw std::invalid_argument("Invalid iterator");
+            auto result = insertUnique(key, std::forward<Args>(args)...);
+            if constexpr (debug_checks)
+            {
+                // The element must sit strictly between its neighbours, as key did
+                const SkipNode<T>* node = result.first.current;
+                if (result.second && ((node->left != head && !_comp(node->left->data, node->data)) ||
+                                      (node->next(1) != tail && !_comp(node->data, node->next(1)->data))))
+                {
+                    eraseNode(result.first.current);
+                    throw std::invalid_argument("try_emplace: constructed element does not match its key");
+                }
+            }
+            return result;
         }
-
-        SkipNode<T>* node = pos.current;
-        ++pos;
-        eraseNode(node);
-        return pos;
+    }
+    // Merge another SkipList
+    /*
+     * Both bottom-level chains are walked once in key order and every tower is
+     * appended again, keeping its height, either to this list or (the loser of a
+     * duplicate pair) back to other: O(n + m), no allocation and no copies of T.
+     * If the comparator throws, the unvisited rests of both chains are appended
+     * unchanged, so both lists stay valid and no element is lost.
+     * Lists with unequal allocators cannot trade towers and move elements one by one.
+     * Lists allowing equivalent keys take every element of other, behind their own
+     * equivalents, and ignore the policy.
+     */
+    void merge(SkipList&& other, merge_policy policy = merge_policy::keep_existing)
+    {
+        if (this == &other || other.empty()) return;
+        if (!(_alloc == other._alloc))
+        {
+            for (auto it = other.begin(); it != other.end();)
+            {
+                SkipNode<T>* existing = multi ? nullptr : findNode(*it);
+                if (!existing)
+                {
+                    insert(std::move(*it));
+                    it = other.erase(it);
+                }else
+                {
+                    if (policy == merge_policy::replace_existing)
+                    {
+                        if constexpr (std::is_swappable_v<T>)
+                        {
+                            using std::swap;
+                            swap(existing->data, *it);
+                        }else
+                        {
+                            // Elements with const parts (map entries) are traded by rebuilding both
+                            T displaced(std::move(existing->data));
+                            eraseNode(existing);
+                            insert(std::move(*it));
+                            it = other.erase(it);
+                            other.insert(std::move(displaced));
+                            continue;
+                        }
+                    }
+                    ++it;
+                }
+            }
+            return;
+        }
+
+        SkipNode<T>* ours = head->next(1);
+        SkipNode<T>* theirs = other.head->next(1);
+        resetHead();
+        current_max_level = 1;
+        _size = 0;
+        other.resetHead();
+        other.current_max_level = 1;
+        other._size = 0;
+        predecessor_path last;
+        predecessor_path other_last;
+        last.fill(head);
+        other_last.fill(other.head);
+        auto take = [](SkipNode<T>*& chain) { SkipNode<T>* node = chain; chain = chain->next(1); return node; };
+        try
+        {
+            while (ours != tail && theirs != other.tail)
+            {
+                if (multi ? !_comp(theirs->data, ours->data) : _comp(ours->data, theirs->data))
+                {
+                    appendTower(take(ours), last.data());
+                }else if (_comp(theirs->data, ours->data))
+                {
+                    appendTower(take(theirs), last.data());
+                }else
+                {
+                    SkipNode<T>* kept = take(ours);
+                    SkipNode<T>* left_over = take(theirs);
+                    if (policy == merge_policy::replace_existing) std::swap(kept, left_over);
+                    appendTower(kept, last.data());
+                    other.appendTower(left_over, other_last.data());
+                }
+            }
+        }catch(...)
+        {
+            while (ours != tail) appendTower(take(ours), last.data());
+            while (theirs != other.tail) other.appendTower(take(theirs), other_last.data());
+            throw;
+        }
+        while (ours != tail) appendTower(take(ours), last.data());
+        while (theirs != other.tail) appendTower(take(theirs), last.data());
+    }
+    void merge(SkipList& other, merge_policy policy = merge_policy::keep_existing)
+    {
+        merge(std::move(other), policy);
+    }
+    // Erase by value
+    template <typename K>
+    bool erase(const K& value)
+    {
+        SkipNode<T>* node = findNode(value);
+        if (node)
+        {
+            eraseNode(node);
+            return true;
+        }
+        return false;
+    }
+    // Erase by iterator
+    iterator erase(iterator pos)
+    {
+        if (pos == end())
+        {
+            throw std::out_of_range("Cannot erase end() iterator");
+        }
+        if constexpr (debug_checks)
+        {
+            if(!validate_iterator(pos))
+            {
+                throw std::invalid_argument("Invalid iterator");
+            }
+        }
+
+        SkipNode<T>* node = pos.current;
+        ++pos;
+        eraseNode(node);
+        return pos;
     }
     // Erase by const_itearator
     iterator erase(const_iterator pos)
     {
-        return erase(iterator(pos.current));
+        return erase(iterator(const_cast<SkipNode<T>*>(pos.current), pos_owner(pos)));
     }
     // Range erase
+    /*
+     * The span is cut out with one search for each end: on every level the last
+     * tower before first is linked straight to the first tower at or after last,
+     * so unlinking costs O(log n) and only freeing the towers is linear.
+     */
     iterator erase(const_iterator first, const_iterator last)
     {
-        if(first == begin() && last == end())
+        SkipNode<T>* span_end = const_cast<SkipNode<T>*>(last.current);
+        if (first == last) return iterator(span_end, tail);
+        if constexpr (debug_checks)
         {
-            clear();
+            if (!validate_iterator(first) || (span_end != tail && !validate_iterator(last)) ||
+                (span_end != tail && _comp(span_end->data, first.current->data)))
+            {
+                throw std::invalid_argument("Invalid iterator range");
+            }
+        }
+        eraseSpan(const_cast<SkipNode<T>*>(first.current), span_end);
+        return iterator(span_end, tail);
+    }
+    // Moves the elements not less than key into a new list and returns it
+    /*
+     * Every level is cut after the last tower before key and the cut-off chains are
+     * hung on the sentinels of the new list: O(log n) pointer updates. Indexable
+     * lists read both sizes off the widths; otherwise the smaller side is counted.
+     * Iterators to moved elements belong to the returned list afterwards.
+     */
+    template <typename K>
+    SkipList split(const K& key)
+    {
+        SkipList upper(fresh_list_t{}, _comp, _alloc);
+        upper._level_gen = _level_gen;
+        upper._finger_enabled = _finger_enabled;
+        predecessor_path update;
+        search_rank rank;
+        SkipNode<T>* first = findPredecessors(key, update.data(), rank.data());
+        _finger_valid = false;
+        if (first == tail) return upper;
+
+        predecessor_path last;
+        collectLastTowers(last.data());
+        size_t lower_size;
+        if constexpr (indexable) lower_size = rank[1];
+        else lower_size = countBefore(first);
+        if constexpr (indexable)
+        {
+            for (int l = 1; l <= MAX_LVL; ++l)
+            {
+                upper.head->width(l) = rank[l] + update[l]->width(l) - lower_size;
+                update[l]->width(l) = lower_size + 1 - rank[l];
+            }
+        }
+        for (int l = 1; l <= current_max_level; ++l)
+        {
+            SkipNode<T>* moved = update[l]->next(l);
+            if (moved == tail) continue;
+            upper.head->next(l) = moved;
+            last[l]->next(l) = upper.tail;
+            update[l]->next(l) = tail;
+        }
+        upper.tail->left = tail->left;
+        first->left = upper.head;
+        tail->left = update[1];
+        upper._size = _size - lower_size;
+        _size = lower_size;
+        upper.current_max_level = current_max_level;
+        upper.trimEmptyLevels();
+        trimEmptyLevels();
+        return upper;
+    }
+    // Moves all elements of other into this list; the key ranges must not overlap
+    /*
+     * The towers of other are spliced in front of the tail (or behind the head)
+     * level by level: O(log n + log m). Lists with unequal allocators cannot swap
+     * towers and fall back to inserting the elements one by one.
+     */
+    void join(SkipList&& other)
+    {
+        if (this == &other || other.empty()) return;
+        // Equivalent keys may meet at the seam when the list allows them
+        auto ordered = [this](const T& lo, const T& hi) { return multi ? !_comp(hi, lo) : _comp(lo, hi); };
+        bool append = empty() || ordered(tail->left->data, other.head->next(1)->data);
+        if (!append && !ordered(other.tail->left->data, head->next(1)->data))
+        {
+            throw std::invalid_argument("join: key ranges overlap");
+        }
+        if (!(_alloc == other._alloc))
+        {
+            for (SkipNode<T>* node = other.head->next(1); node != other.tail; node = node->next(1))
+            {
+                insert(std::move(node->data));
+            }
+            other.clear();
+            return;
+        }
+        if (!append)
+        {
+            // Our towers go after those of other: trade chains, then append as usual
+            std::swap(head, other.head);
+            std::swap(tail, other.tail);
+            std::swap(current_max_level, other.current_max_level);
+            std::swap(_size, other._size);
+            if constexpr (persistent)
+            {
+                // The saved list stays with the object that owned it
+                SkipListRoot& root = *_node_alloc.root();
+                SkipList* owner = root.head == head ? &other : root.head == other.head ? this : nullptr;
+                if (owner)
+                {
+                    root.head = owner->head;
+                    root.tail = owner->tail;
+                }
+            }
+        }
+
+        predecessor_path last;
+        predecessor_path other_last;
+        collectLastTowers(last.data());
+        other.collectLastTowers(other_last.data());
+        if constexpr (indexable)
+        {
+            // Positions in other shift by size(); the links into the tail of other stay valid
+            for (int l = 1; l <= MAX_LVL; ++l)
+            {
+                last[l]->width(l) += other.head->width(l) - 1;
+            }
         }
-        while(first != last)
+        for (int l = 1; l <= other.current_max_level; ++l)
         {
-            first = erase(first);
+            last[l]->next(l) = other.head->next(l);
+            other_last[l]->next(l) = tail;
         }
-        return iterator(first.current);
+        other.head->next(1)->left = tail->left;
+        tail->left = other.tail->left;
+        current_max_level = std::max(current_max_level, other.current_max_level);
+        _size += other._size;
+        _finger_valid = false;
+
+        other.resetHead();
+        other.current_max_level = 1;
+        other._size = 0;
     }
     // Find element
     template <typename K>
     iterator find(const K& key)
     {
         SkipNode<T>* node = findNode(key);
-        return (node) ? iterator(node) : end();
+        return (node) ? iterator(node, tail) : end();
     }
     template <typename K>
     const_iterator find(const K& key) const
     {
         const SkipNode<T>* node = findNode(key);
-        return (node) ? const_iterator(node) : cend();
+        return (node) ? const_iterator(node, tail) : cend();
     }
     // Check for existence
-    bool contains(const T& value) const 
+    template <typename K>
+    bool contains(const K& value) const
     {
         return findNode(value) != nullptr;
     }
@@ -483,37 +1131,197 @@ public:
     template <typename K>
     iterator lower_bound(const K& key)
     {
-        SkipNode<T>* node = head;
-
-        for(int lvl = current_max_level; lvl >= 1; --lvl)
+        return iterator(lowerBoundNode(key), tail);
+    }
+    template <typename K>
+    const_iterator lower_bound(const K& key) const
+    {
+        return const_iterator(lowerBoundNode(key), tail);
+    }
+    // First greater than key
+    template <typename K>
+    iterator upper_bound(const K& key)
+    {
+        return iterator(upperBoundNode(key), tail);
+    }
+    template <typename K>
+    const_iterator upper_bound(const K& key) const
+    {
+        return const_iterator(upperBoundNode(key), tail);
+    }
+    // Lazy view of the elements not less than lo and less than hi (see range_view)
+    template <typename L, typename H>
+    range_view<iterator, H> range(const L& lo, const H& hi)
+    {
+        return range_view<iterator, H>(lower_bound(lo), this, hi);
+    }
+    template <typename L, typename H>
+    range_view<const_iterator, H> range(const L& lo, const H& hi) const
+    {
+        return range_view<const_iterator, H>(lower_bound(lo), this, hi);
+    }
+    // Elements equivalent to key: one search, then a walk over the equivalents
+    template <typename K>
+    std::ranges::subrange<iterator> equal_range(const K& key)
+    {
+        SkipNode<T>* first = lowerBoundNode(key);
+        return {iterator(first, tail), iterator(pastEquivalents(first, key), tail)};
+    }
+    template <typename K>
+    std::ranges::subrange<const_iterator> equal_range(const K& key) const
+    {
+        SkipNode<T>* first = lowerBoundNode(key);
+        return {const_iterator(first, tail), const_iterator(pastEquivalents(first, key), tail)};
+    }
+    // Calls f on every element, on several threads, in no particular order
+    /*
+     * The bottom level is cut into runs of similar length at towers of a high level
+     * (see partitionTowers), one run per worker. f must be safe to call concurrently
+     * and must not change the order of the element it gets. The first exception
+     * thrown by f is rethrown once every worker is done.
+     */
+    template <typename Func>
+    void for_each(parallel_t policy, Func f)
+    {
+        forEachRun(policy, [&f](SkipNode<T>* node) { f(node->data); });
+    }
+    template <typename Func>
+    void for_each(parallel_t policy, Func f) const
+    {
+        forEachRun(policy, [&f](const SkipNode<T>* node) { f(std::as_const(node->data)); });
+    }
+    // Hinted lookups
+    /*
+     * The search climbs from hint instead of descending from head, so a key d
+     * elements after hint costs O(log d). Keys before hint (other than its left
+     * neighbour) fall back to a search from head.
+     */
+    template <typename K>
+    iterator find_from(const_iterator hint, const K& key)
+    {
+        SkipNode<T>* node = lowerBoundFrom(hintStart(hint, key), key);
+        return (node != tail && !_comp(key, node->data)) ? iterator(node, tail) : end();
+    }
+    template <typename K>
+    const_iterator find_from(const_iterator hint, const K& key) const
+    {
+        const SkipNode<T>* node = lowerBoundFrom(hintStart(hint, key), key);
+        return (node != tail && !_comp(key, node->data)) ? const_iterator(node, tail) : cend();
+    }
+    template <typename K>
+    iterator lower_bound_from(const_iterator hint, const K& key)
+    {
+        return iterator(lowerBoundFrom(hintStart(hint, key), key), tail);
+    }
+    template <typename K>
+    const_iterator lower_bound_from(const_iterator hint, const K& key) const
+    {
+        return const_iterator(lowerBoundFrom(hintStart(hint, key), key), tail);
+    }
+    // Positional access (indexable lists only)
+    /*
+     * The descent adds up the widths of the links it follows, so positions are
+     * found in O(log n) like keys. Positions are 0-based.
+     */
+    // k-th smallest element, end() if k >= size()
+    iterator nth(size_t k) requires Indexable
+    {
+        return iterator(nodeAt(k + 1), tail);
+    }
+    const_iterator nth(size_t k) const requires Indexable
+    {
+        return const_iterator(nodeAt(k + 1), tail);
+    }
+    // Number of elements less than key (the position of lower_bound(key))
+    template <typename K>
+    size_t rank(const K& key) const requires Indexable
+    {
+        const SkipNode<T>* current_node = head;
+        size_t position = 0;
+        for (int l = current_max_level; l >= 1; --l)
         {
-            SkipNode<T>* curr_tail = getTailAtLevel(lvl);
-            while(node->right != curr_tail && _comp(node->right->data, key))
+            while (current_node->next(l) != tail && _comp(current_node->next(l)->data, key))
             {
-                node = node->right;
+                position += current_node->width(l);
+                current_node = current_node->next(l);
             }
-            if(lvl > 1) node = node->down;
         }
-        return iterator(node->right);
+        return position;
     }
-    // First greater than key
+    // Number of elements in [lo, hi)
     template <typename K>
-    iterator upper_bound(const K& key)
+    size_t count_range(const K& lo, const K& hi) const requires Indexable
+    {
+        return _comp(lo, hi) ? rank(hi) - rank(lo) : 0;
+    }
+    // Position of the element at pos, size() for end()
+    /*
+     * Found from the tower itself, so it is exact among equivalent elements too:
+     * the top link of each tower is followed to the tail, adding up the widths,
+     * which is the distance from pos to the end in O(log n) expected steps.
+     */
+    size_t index_of(const_iterator pos) const requires Indexable
+    {
+        size_t to_tail = 0;
+        for (const SkipNode<T>* node = pos.current; node != tail; node = node->next(node->height))
+        {
+            to_tail += node->width(node->height);
+        }
+        return _size - to_tail;
+    }
+    // Number of increments from first to last, without walking the range
+    difference_type distance(const_iterator first, const_iterator last) const requires Indexable
+    {
+        return static_cast<difference_type>(index_of(last)) - static_cast<difference_type>(index_of(first));
+    }
+    // Batched lookups, results written to out in input order
+    /*
+     * The probe keys are visited in sorted order and every search climbs the path
+     * left by the previous one, so a batch of m keys over n elements costs
+     * O(m log(n/m)) steps and the lower levels stay in cache between neighbours.
+     * Already sorted batches skip the sort. On lists too large for the cache the
+     * sorted batch is split between several interleaved searches whose memory
+     * accesses overlap (see interleavedLookup).
+     */
+    template <typename ForwardIt, typename OutputIt>
+    OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out)
+    {
+        return batchLookup(first, last, out, [this](SkipNode<T>* node) { return node ? iterator(node, tail) : end(); });
+    }
+    template <typename ForwardIt, typename OutputIt>
+    OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return batchLookup(first, last, out, [this](const SkipNode<T>* node) { return node ? const_iterator(node, tail) : cend(); });
+    }
+    template <typename ForwardIt, typename OutputIt>
+    OutputIt contains_batch(ForwardIt first, ForwardIt last, OutputIt out) const
     {
-        iterator it = lower_bound(key);
-        return (it != end() && !_comp(key, *it)) ? ++it : it;
+        return batchLookup(first, last, out, [](const SkipNode<T>* node) { return node != nullptr; });
     }
-    // Maximum possible amount of levels
-    size_t max_size() const
+    // Maximum possible amount of elements (one single-level tower each)
+    size_t max_size() const noexcept
     {
-        size_t max_size = MAX_LVL;
-        return max_size;
+        return std::allocator_traits<node_allocator>::max_size(_node_alloc) / node_units(1);
     }
+    // Tower height cap (the MaxLevel template argument)
+    static constexpr int max_level() noexcept { return MAX_LVL; }
     // Current number of elements
     size_t size() const { return _size; }
     
     
-    Compare key_comp() { return _comp; }
+    Compare key_comp() const { return _comp; }
+    // Level generator used for new towers (can be reseeded for reproducible runs)
+    SkipLevelGenerator& level_generator() noexcept { return _level_gen; }
+    const SkipLevelGenerator& level_generator() const noexcept { return _level_gen; }
+    // Finger: searches start from the path of the previous search instead of head,
+    // so runs of nearby keys (e.g. near-monotonic appends) cost O(log d) each.
+    // Off by default; not available for indexable lists
+    void use_finger(bool enabled) noexcept requires (!Indexable)
+    {
+        _finger_enabled = enabled;
+        _finger_valid = false;
+    }
+    bool uses_finger() const noexcept { return fingerActive(); }
     allocator_type get_allocator() {return _alloc; };
 
     // Swap continers
@@ -528,6 +1336,10 @@ public:
         swap(a.current_max_level, b.current_max_level);
         swap(a._comp, b._comp);
         swap(a._size, b._size);
+        swap(a._level_gen, b._level_gen);
+        swap(a._finger, b._finger);
+        swap(a._finger_valid, b._finger_valid);
+        swap(a._finger_enabled, b._finger_enabled);
 
         
         if constexpr (std::allocator_traits<Allocator>::propagate_on_container_swap::value)
@@ -540,116 +1352,377 @@ public:
     // Reset to empty state
     void clear()
     {
-        SkipNode<T>* current_level = head;
-        while(current_level != nullptr)
+        SkipNode<T>* current_node = head->next(1);
+        while(current_node != tail)
         {
-            SkipNode<T>* current_node = current_level;
-            while(current_node != nullptr)
-            {
-                SkipNode<T>* next_node = current_node->right;
-                delete_node(current_node);
-                current_node = next_node;
-            }
+            SkipNode<T>* next_node = current_node->next(1);
+            delete_node(current_node);
+            current_node = next_node;
         }
-        head = create_node(T());
-        tail = create_node(T());
-        head->right = tail;
-        tail->left = head;
+        resetHead();
+        current_max_level = 1;
+        _size = 0;
+    }
+    // Rebuild the towers into the balanced shape in one linear sweep
+    /*
+     * The i-th element gets the height balanced_level(i), as assign_sorted(..., true)
+     * would give it. Towers that already have that height are relinked as they are;
+     * the others are replaced by a tower of the right height that the element is
+     * moved into, which invalidates iterators and references to them. If building a
+     * replacement throws, the remaining towers keep their heights, the list is left
+     * valid and the exception is rethrown.
+     */
+    void rebalance()
+    {
+        SkipNode<T>* current_node = head->next(1);
+        resetHead();
         current_max_level = 1;
         _size = 0;
+        predecessor_path last;
+        last.fill(head);
+        std::exception_ptr failure;
+        for (size_t index = 1; current_node != tail; ++index)
+        {
+            SkipNode<T>* node = current_node;
+            current_node = current_node->next(1);
+            int level = balanced_level(index);
+            if (!failure && node->height != level)
+            {
+                try
+                {
+                    SkipNode<T>* replacement = create_node(level, std::move_if_noexcept(node->data));
+                    delete_node(node);
+                    node = replacement;
+                }catch (...)
+                {
+                    failure = std::current_exception();
+                }
+            }
+            appendTower(node, last.data());
+        }
+        if (failure) std::rethrow_exception(failure);
     }
     // Check if continer is correct
     bool validate() const
     {
         for (int lvl = 1; lvl <= current_max_level; ++lvl) {
-            SkipNode<T>* node = getHeadAtLevel(lvl);
-            while (node != getTailAtLevel(lvl)) {
+            const SkipNode<T>* node = head;
+            while (node != tail) {
+                const SkipNode<T>* next_node = node->next(lvl);
+
+                if (!next_node) {
+                    std::cerr << "Broken link at level " << lvl << std::endl;
+                    return false;
+                }
 
-                if (node->right && node->right->left != node) {
+                if (lvl == 1 && next_node->left != node) {
                     std::cerr << "Pointer mismatch at level " << lvl << std::endl;
                     return false;
                 }
 
-                if (node->right != getTailAtLevel(lvl) && node->right && _comp(node->right->data, node->data)) {
+                if (node != head && next_node != tail &&
+                    (multi ? _comp(next_node->data, node->data) : !_comp(node->data, next_node->data))) {
                     std::cerr << "Order violation at level " << lvl 
-                              << ": " << node->data << " > " << node->right->data << std::endl;
+                              << ": " << printable(node->data) << " >= " << printable(next_node->data) << std::endl;
                     return false;
                 }
 
-                if (lvl > 1 && !node->down) {
-                    std::cerr << "Missing down pointer at level " << lvl << " node: "<< node->data << std::endl;
+                if (node != head && node->height < lvl) {
+                    std::cerr << "Tower too short at level " << lvl << " node: "<< printable(node->data) << std::endl;
                     return false;
                 }
                 
-                node = node->right;
+                node = next_node;
+            }
+        }
+        if constexpr (indexable)
+        {
+            // Following width(l) bottom-level steps must land on next(l)
+            for (int lvl = 1; lvl <= MAX_LVL; ++lvl) {
+                const SkipNode<T>* bottom = head;
+                for (const SkipNode<T>* node = head; node != tail; node = node->next(lvl)) {
+                    size_t step = 0;
+                    for (; step < node->width(lvl) && bottom != tail; ++step) {
+                        bottom = bottom->next(1);
+                    }
+                    if (step != node->width(lvl) || bottom != node->next(lvl)) {
+                        std::cerr << "Width mismatch at level " << lvl << std::endl;
+                        return false;
+                    }
+                }
             }
         }
+        size_t count = 0;
+        for (const SkipNode<T>* node = head->next(1); node != tail; node = node->next(1)) ++count;
+        if (count != _size) {
+            std::cerr << "Size mismatch: " << count << " != " << _size << std::endl;
+            return false;
+        }
         return true;
     }
     
-    // Operators to compare containers
-    friend bool operator==(const SkipList& lsl, const SkipList& rsl)
+    // Shape of the list and hot-path counters (see SkipListStats), O(n)
+    SkipListStats stats() const
     {
-        if(lsl.size() != rsl.size()) return false;
-
-        auto itl = lsl.begin();
-        auto itr = rsl.begin();
-        while(itl != lsl.end() && itr != rsl.end())
+        SkipListStats result;
+#if SKIPLIST_STATS
+        for (size_t SkipListStats::* counter : counter_fields)
         {
-            if(!(*itl == *itr)) return false;
-            ++itl;
-            ++itr;
+            result.*counter = std::atomic_ref<size_t>(_counters.*counter).load(std::memory_order_relaxed);
         }
-        return true;
+#endif
+        result.size = _size;
+        result.current_max_level = current_max_level;
+        result.max_level = MAX_LVL;
+        result.promotion_probability = _level_gen.promotion_probability();
+        result.level_histogram.assign(MAX_LVL + 1, 0);
+        result.bytes_in_use = (node_units(MAX_LVL) + node_units(1)) * sizeof(SkipNodeWord<T>);
+        for (const SkipNode<T>* node = head->next(1); node != tail; node = node->next(1))
+        {
+            ++result.level_histogram[node->height];
+            result.bytes_in_use += node_units(node->height) * sizeof(SkipNodeWord<T>);
+        }
+        result.expected_path_length = expectedPathLength();
+        return result;
     }
-    friend bool operator!=(const SkipList& lsl, const SkipList& rsl)
+    // Whether the towers have drifted far enough from a good shape to be worth a
+    // rebalance(): the expected path exceeds factor times the (1 - p) / p * log_{1/p}(size)
+    // links of a random list (a balanced one needs about half of that)
+    bool needs_rebalance(double factor = 2.0) const
     {
-        return !(lsl == rsl);
+        if (_size < 2) return false;
+        double p = _level_gen.promotion_probability();
+        double random_path = (1.0 - p) / p * std::log(static_cast<double>(_size)) / std::log(1.0 / p);
+        return expectedPathLength() > factor * random_path;
     }
-    friend bool operator<(const SkipList& lsl, const SkipList& rsl)
+    // Rebalances if needs_rebalance(factor); returns whether it did
+    bool rebalance_if_needed(double factor = 2.0)
     {
-        auto itl = lsl.begin();
-        auto itr = rsl.begin();
-
-        while(itl != lsl.end() && itr != rsl.end())
-        {
-            if(*itl < *itr) return true;
-            if(*itr < *itl) return false;
-            ++itl;
-            ++itr;
-        }
-        return lsl.size() < rsl.size();
+        if (!needs_rebalance(factor)) return false;
+        rebalance();
+        return true;
     }
-    friend bool operator<=(const SkipList& lsl, const SkipList& rsl)
+    // Path a descent from head takes towards key, top level first (diagnostics only:
+    // neither counted in the stats nor started from the finger)
+    template <typename K>
+    std::vector<SkipListPathLevel<T>> search_path(const K& key) const
     {
-        return !(rsl < lsl);
+        std::vector<SkipListPathLevel<T>> path;
+        path.reserve(current_max_level);
+        const SkipNode<T>* node = head;
+        for (int lvl = current_max_level; lvl >= 1; --lvl)
+        {
+            SkipListPathLevel<T> step;
+            step.level = lvl;
+            while (node->next(lvl) != tail && _comp(node->next(lvl)->data, key))
+            {
+                node = node->next(lvl);
+                ++step.steps;
+            }
+            if (node != head) step.predecessor = &node->data;
+            if (node->next(lvl) != tail) step.next = &node->next(lvl)->data;
+            path.push_back(step);
+        }
+        return path;
     }
-    friend bool operator>(const SkipList& lsl, const SkipList& rsl)
+    // Zeroes the hot-path counters
+    void reset_stats() noexcept
     {
-        return rsl < lsl;
+#if SKIPLIST_STATS
+        _counters = SkipListStats();
+#endif
     }
-    friend bool operator>=(const SkipList& lsl, const SkipList& rsl)
+    // Writes stats() as one line of JSON
+    void printStats(std::ostream& os = std::cout) const
     {
-        return !(lsl < rsl);
+        stats().write_json(os);
     }
 
-    // Print specific level
-    void printLevel(int level) const
+    // Write the elements in order as a compact binary stream (see load)
+    /*
+     * Format: "SKL", a version byte and a flags byte, then the element size and the
+     * element count as varints, then one record per element: its tower height as a
+     * varint if requested, and the element itself. Integer keys are zigzag varints
+     * of the difference to the previous key (one byte for dense keys, whatever the
+     * comparator); contiguous containers of trivially copyable values (std::string)
+     * are a varint length plus their bytes; other trivially copyable types are raw
+     * bytes in host byte order. Records are encoded into a buffer flushed in chunks.
+     */
+    void save(std::ostream& os, save_options options = {}) const
     {
-        SkipNode<T>* node = getHeadAtLevel(level);
-        std::cout << "Level " << level << ": ";
-        while (node != getTailAtLevel(level)) {
-            std::cout << node->data << " ";
-            node = node->right;
+        const bool varint = options.varint_keys && varint_codable;
+        std::string buffer{'S', 'K', 'L', static_cast<char>(save_version),
+                           static_cast<char>((varint ? save_varint_flag : 0) | (options.tower_heights ? save_heights_flag : 0))};
+        putVarint(buffer, sizeof(T));
+        putVarint(buffer, _size);
+        std::uint64_t prev = 0;
+        for (const SkipNode<T>* node = head->next(1); node != tail; node = node->next(1))
+        {
+            if (options.tower_heights) putVarint(buffer, node->height);
+            putValue(buffer, node->data, varint, prev);
+            if (buffer.size() >= save_chunk)
+            {
+                os.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
         }
-        std::cout << std::endl;
+        os.write(buffer.data(), buffer.size());
     }
-    //Print all levels
-    void printAllLevels() const
-    {
+    // Replace the contents with a stream written by save, in linear time
+    /*
+     * Records are decoded straight into towers appended left to right, as in
+     * assign_sorted: no searches and no per-element insert. Saved heights are
+     * reused, otherwise heights are drawn from the level generator. Throws
+     * std::invalid_argument if the stream is truncated, was written for another
+     * element type, or is out of order; the list is left empty then.
+     */
+    void load(std::istream& is)
+    {
+        std::streambuf& in = *is.rdbuf();
+        char header[5];
+        if (in.sgetn(header, 5) != 5 || std::string_view(header, 3) != "SKL" ||
+            static_cast<unsigned char>(header[3]) != save_version)
+        {
+            throw std::invalid_argument("load: not a SkipList stream");
+        }
+        const unsigned flags = static_cast<unsigned char>(header[4]);
+        const bool varint = flags & save_varint_flag;
+        const bool heights = flags & save_heights_flag;
+        if ((flags & ~(save_varint_flag | save_heights_flag)) || (varint && !varint_codable) || getVarint(in) != sizeof(T))
+        {
+            throw std::invalid_argument("load: stream was saved for another element type");
+        }
+        const std::uint64_t count = getVarint(in);
+        clear();
+        try
+        {
+            predecessor_path last_tower;
+            last_tower.fill(head);
+            std::uint64_t prev = 0;
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                int level = heights ? static_cast<int>(std::min<std::uint64_t>(getVarint(in), MAX_LVL + 1)) : random_level();
+                if (level < 1 || level > MAX_LVL)
+                {
+                    throw std::invalid_argument("load: tower height out of range");
+                }
+                SkipNode<T>* new_node = create_node(level, getValue(in, varint, prev));
+                const SkipNode<T>* before = last_tower[1];
+                if (before != head && (multi ? _comp(new_node->data, before->data) : !_comp(before->data, new_node->data)))
+                {
+                    delete_node(new_node);
+                    throw std::invalid_argument("load: stream is not sorted");
+                }
+                appendTower(new_node, last_tower.data());
+            }
+        }catch(...)
+        {
+            clear();
+            throw;
+        }
+    }
+
+    // Operators to compare containers
+    friend bool operator==(const SkipList& lsl, const SkipList& rsl)
+    {
+        if(lsl.size() != rsl.size()) return false;
+
+        auto itl = lsl.begin();
+        auto itr = rsl.begin();
+        while(itl != lsl.end() && itr != rsl.end())
+        {
+            if(!(*itl == *itr)) return false;
+            ++itl;
+            ++itr;
+        }
+        return true;
+    }
+    friend bool operator!=(const SkipList& lsl, const SkipList& rsl)
+    {
+        return !(lsl == rsl);
+    }
+    friend bool operator<(const SkipList& lsl, const SkipList& rsl)
+    {
+        auto itl = lsl.begin();
+        auto itr = rsl.begin();
+
+        while(itl != lsl.end() && itr != rsl.end())
+        {
+            if(*itl < *itr) return true;
+            if(*itr < *itl) return false;
+            ++itl;
+            ++itr;
+        }
+        return lsl.size() < rsl.size();
+    }
+    friend bool operator<=(const SkipList& lsl, const SkipList& rsl)
+    {
+        return !(rsl < lsl);
+    }
+    friend bool operator>(const SkipList& lsl, const SkipList& rsl)
+    {
+        return rsl < lsl;
+    }
+    friend bool operator>=(const SkipList& lsl, const SkipList& rsl)
+    {
+        return !(lsl < rsl);
+    }
+
+    // Set algebra over two lists ordered by the same comparator, in one O(n + m) sweep;
+    // the result is configured like a copy of lsl and takes equivalent elements from lsl
+    friend SkipList set_union(const SkipList& lsl, const SkipList& rsl)
+    {
+        return combine(lsl, rsl, true, true, true);
+    }
+    friend SkipList set_intersection(const SkipList& lsl, const SkipList& rsl)
+    {
+        return combine(lsl, rsl, false, true, false);
+    }
+    friend SkipList set_difference(const SkipList& lsl, const SkipList& rsl)
+    {
+        return combine(lsl, rsl, true, false, false);
+    }
+    friend SkipList set_symmetric_difference(const SkipList& lsl, const SkipList& rsl)
+    {
+        return combine(lsl, rsl, true, false, true);
+    }
+    // Parallel versions: both lists are cut at the same keys, taken from towers of the
+    // larger one, and each pair of runs is combined by its own worker
+    friend SkipList set_union(parallel_t policy, const SkipList& lsl, const SkipList& rsl)
+    {
+        return combineParallel(policy, lsl, rsl, true, true, true);
+    }
+    friend SkipList set_intersection(parallel_t policy, const SkipList& lsl, const SkipList& rsl)
+    {
+        return combineParallel(policy, lsl, rsl, false, true, false);
+    }
+    friend SkipList set_difference(parallel_t policy, const SkipList& lsl, const SkipList& rsl)
+    {
+        return combineParallel(policy, lsl, rsl, true, false, false);
+    }
+    friend SkipList set_symmetric_difference(parallel_t policy, const SkipList& lsl, const SkipList& rsl)
+    {
+        return combineParallel(policy, lsl, rsl, true, false, true);
+    }
+
+    // Print specific level
+    void printLevel(int level) const
+    {
+        const SkipNode<T>* node = head;
+        std::cout << "Level " << level << ": ";
+        while (node != tail) {
+            std::cout << node->data << " ";
+            node = node->next(level);
+        }
+        std::cout << std::endl;
+    }
+    //Print all levels, followed by the stats() line if requested
+    void printAllLevels(bool with_stats = false) const
+    {
         for (int lvl = current_max_level; lvl >= 1; --lvl) {
             printLevel(lvl);
         }
+        if (with_stats) printStats();
     }
     
     
@@ -660,198 +1733,1409 @@ private:
     SkipNode<T>* head;
     SkipNode<T>* tail;
     int current_max_level = 1;
-    static constexpr int DEFAULT_MAX_LVL = 16;
-    int MAX_LVL = DEFAULT_MAX_LVL;
+    // Fixed at compile time, so level loops have constant bounds
+    static constexpr int MAX_LVL = MaxLevel;
+    // Per-level predecessors of a search, kept on the stack (index 0 unused)
+    using predecessor_path = std::array<SkipNode<T>*, MAX_LVL + 1>;
+    // Positions of those predecessors (indexable lists only)
+    using search_rank = std::array<size_t, MAX_LVL + 1>;
     size_t _size = 0;
+    SkipLevelGenerator _level_gen;
+    // Predecessors found by the last search; valid while every change since went
+    // through a search (hinted and bulk inserts invalidate it)
+    mutable predecessor_path _finger{};
+    mutable bool _finger_valid = false;
+    bool _finger_enabled = false;
+    static constexpr bool debug_checks = SKIPLIST_DEBUG_CHECKS;
+#if SKIPLIST_STATS
+    // Hot-path counters of stats(); copies start from zero, move and swap leave them in place.
+    // Const lookups may run concurrently (e.g. under a shared lock), so they are only
+    // touched through relaxed atomic_refs
+    mutable SkipListStats _counters;
+    static constexpr size_t SkipListStats::* counter_fields[] = {
+        &SkipListStats::searches, &SkipListStats::search_steps, &SkipListStats::comparisons,
+        &SkipListStats::nodes_allocated, &SkipListStats::bytes_allocated, &SkipListStats::nodes_freed,
+        &SkipListStats::bytes_freed, &SkipListStats::level_growths, &SkipListStats::level_trims};
+#endif
+    static constexpr bool indexable = Indexable;
+    // Comparators declaring equivalent_keys (SkipMultiMap) let equivalent elements coexist,
+    // in insertion order
+    static constexpr bool multi = requires { requires Compare::equivalent_keys::value; };
+    // Allocators that free everything when their last copy dies (see SkipListArena.h)
+    static constexpr bool bulk_release = requires { requires node_allocator::bulk_release::value; };
+    // Allocators whose towers outlive the process and that keep a SkipListRoot (see SkipListMmap.h)
+    static constexpr bool persistent = requires { requires node_allocator::persistent::value; };
+    static_assert(!persistent || std::is_trivially_copyable_v<T>, "persistent lists need trivially copyable elements");
+    // Identifies the tower layout a saved list was written with
+    static constexpr std::uint64_t layout_tag = (std::uint64_t{sizeof(T)} << 40) | (std::uint64_t{sizeof(SkipNode<T>)} << 24) |
+                                                (std::uint64_t{sizeof(SkipNodeWord<T>)} << 8) | indexable;
+    // Element encodings of save and load
+    static constexpr bool varint_codable = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+    static constexpr bool length_codable = requires (T& value, size_t n)
+    {
+        requires std::ranges::contiguous_range<T>;
+        requires std::is_trivially_copyable_v<std::ranges::range_value_t<T>>;
+        value.resize(n);
+    };
+    static constexpr unsigned save_version = 1;
+    static constexpr unsigned save_varint_flag = 1;
+    static constexpr unsigned save_heights_flag = 2;
+    static constexpr size_t save_chunk = 1 << 16;
+    // Allocators without state (std::allocator) are assumed safe to call from several threads
+    static constexpr bool parallel_alloc = std::allocator_traits<node_allocator>::is_always_equal::value && !persistent;
+    // Fewest elements handed to one worker of a parallel operation
+    static constexpr size_t parallel_grain = 1 << 12;
+    // Towers built by one worker of a parallel build, linked among themselves;
+    // positions count from 1 within the chunk
+    struct chunk_chain
+    {
+        predecessor_path first{};   // first tower of each level, nullptr if none
+        predecessor_path last{};    // last tower of each level
+        search_rank first_pos{};
+        search_rank last_pos{};
+        size_t count = 0;
+        size_t units = 0;      // allocation units of all towers
+        int height = 1;        // tallest tower
+        std::exception_ptr error;
+    };
+    // Tag of the constructor for internal result lists, which never adopt a saved list
+    struct fresh_list_t {};
+    SkipList(fresh_list_t, const Compare& comp, const Allocator& alloc)
+        : _alloc(alloc),
+          _node_alloc(alloc),
+          _comp(comp)
+    {
+        initSentinels();
+    }
     
-    // Creates a new node with given value using the allocator
-    SkipNode<T>* create_node(const T& value)
+    // Number of allocation units occupied by a tower of the given height
+    static constexpr size_t node_units(int height) noexcept
     {
-        SkipNode<T>* node = _node_alloc.allocate(1);
+        size_t link_bytes = sizeof(SkipNode<T>*) + (indexable ? sizeof(size_t) : 0);
+        return (sizeof(SkipNode<T>) + height * link_bytes + sizeof(SkipNodeWord<T>) - 1) / sizeof(SkipNodeWord<T>);
+    }
+    // Creates a new tower of given height using the allocator, forward pointers are nulled
+    template <typename... Args>
+    SkipNode<T>* create_node(int height, Args&&... args)
+    {
+        SkipNode<T>* node = allocate_node(height, std::forward<Args>(args)...);
+        tally(&SkipListStats::nodes_allocated);
+        tally(&SkipListStats::bytes_allocated, node_units(height) * sizeof(SkipNodeWord<T>));
+        return node;
+    }
+    // create_node without the counters, for workers of parallel builds
+    template <typename... Args>
+    SkipNode<T>* allocate_node(int height, Args&&... args)
+    {
+        SkipNodeWord<T>* raw = std::allocator_traits<node_allocator>::allocate(_node_alloc, node_units(height));
+        SkipNode<T>* node = reinterpret_cast<SkipNode<T>*>(raw);
         try
         {
-            std::allocator_traits<node_allocator>::construct(_node_alloc, node, value);
-            node->left = nullptr;
-            node->right = nullptr;
-            node->down = nullptr;
-            //std::cout << "Node allocated at: " << node << std::endl; // debug
+            std::allocator_traits<node_allocator>::construct(_node_alloc, node, height, std::forward<Args>(args)...);
+            for (int l = 1; l <= height; ++l)
+            {
+                node->next(l) = nullptr;
+            }
         }catch(...)
         {
-            std::cout<<"caught error"<<std::endl;
-            _node_alloc.deallocate(node, 1);
+            std::allocator_traits<node_allocator>::deallocate(_node_alloc, raw, node_units(height));
             throw;
         }
         return node;
     }
-    // Properly deallocates a node using the allocator
+    // Properly deallocates a tower using the allocator
     void delete_node(SkipNode<T>* node)
     {
         if(node)
         {
+            size_t units = node_units(node->height);
             std::allocator_traits<node_allocator>::destroy(_node_alloc, node);
-            _node_alloc.deallocate(node, 1);
+            std::allocator_traits<node_allocator>::deallocate(_node_alloc, reinterpret_cast<SkipNodeWord<T>*>(node), units);
+            tally(&SkipListStats::nodes_freed);
+            tally(&SkipListStats::bytes_freed, units * sizeof(SkipNodeWord<T>));
         }        
     }
-    // Generates a random level for new nodes (geometric distribution)
-    int random_level()
+    // Allocates head (spanning MAX_LVL levels) and tail sentinels of an empty list
+    void initSentinels()
     {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::bernoulli_distribution dist(0.5);
-
-        int level = 1;
-        while (dist(gen) && level < MAX_LVL) {
-            level++;
+        head = create_node(MAX_LVL);
+        try
+        {
+            tail = create_node(1);
+        }catch(...)
+        {
+            delete_node(head);
+            throw;
         }
-        return level;
-
+        resetHead();
+    }
+    // Sentinels of a newly constructed list. Persistent allocators hand over the list
+    // they saved unless another list has it open; if they hold none, this one is saved
+    void openSaved()
+    {
+        if constexpr (persistent)
+        {
+            SkipListRoot& root = *_node_alloc.root();
+            if (root.head && !root.attached)
+            {
+                if (root.layout != layout_tag || root.max_level != MAX_LVL)
+                {
+                    throw std::invalid_argument("SkipList: saved list has a different tower layout");
+                }
+                head = static_cast<SkipNode<T>*>(root.head);
+                tail = static_cast<SkipNode<T>*>(root.tail);
+                _size = root.size;
+                current_max_level = root.current_max_level;
+                if (root.relocation) rebaseSaved(root.relocation);
+                if (root.recover) recoverSaved();
+                root.head = head;
+                root.tail = tail;
+                root.relocation = 0;
+                root.recover = false;
+                root.attached = true;
+                return;
+            }
+            initSentinels();
+            if (!root.head)
+            {
+                root = SkipListRoot{head, tail, 0, 1, MAX_LVL, layout_tag, true};
+            }
+            return;
+        }
+        initSentinels();
     }
-    // Gets the head node at a specific level
-    SkipNode<T>* getHeadAtLevel(int level) const
+    // Adds delta to every link of the adopted towers, whose file is now mapped delta
+    // bytes away from where they were linked
+    void rebaseSaved(std::int64_t delta) noexcept
     {
-        if (level < 1 || level > current_max_level) return nullptr;
-        SkipNode<T>* current_head = head;
-        int current_level = current_max_level;
-        while ((level < current_level) && (current_head->down))
+        auto rebase = [delta](SkipNode<T>* node) {
+            return reinterpret_cast<SkipNode<T>*>(reinterpret_cast<std::uintptr_t>(node) + static_cast<std::uintptr_t>(delta));
+        };
+        head = rebase(head);
+        tail = rebase(tail);
+        for (SkipNode<T>* node = head; node != tail; node = node->next(1))
         {
-            current_head = current_head->down;
-            current_level--;
+            for (int l = 1; l <= node->height; ++l)
+            {
+                node->next(l) = rebase(node->next(l));
+            }
+            if (node != head) node->left = rebase(node->left);
         }
-        return current_head;
+        tail->left = rebase(tail->left);
     }
-    // Gets the tail node at a specific level
-    SkipNode<T>* getTailAtLevel(int level) const
+    // Relinks the adopted towers of a list whose process died with it open
+    /*
+     * Inserts link and erases unlink the bottom level with a single store, so it
+     * holds every element whatever the upper levels were doing at the time of the
+     * crash. The towers are appended again along it with their heights kept, which
+     * rebuilds the upper levels and the left links and recounts the size.
+     */
+    void recoverSaved()
     {
-        if (level < 1 || level > current_max_level) return nullptr;
-        SkipNode<T>* current_tail = tail;
-        int current_level = current_max_level;
-        while ((level < current_level) && (current_tail->down))
+        SkipNode<T>* current_node = head->next(1);
+        resetHead();
+        current_max_level = 1;
+        _size = 0;
+        predecessor_path last;
+        last.fill(head);
+        while (current_node != tail)
         {
-            current_tail = current_tail->down;
-            current_level--;
+            SkipNode<T>* node = current_node;
+            current_node = current_node->next(1);
+            appendTower(node, last.data());
+        }
+        if (!validate())
+        {
+            throw std::runtime_error("SkipList: saved list is damaged");
         }
-        return current_tail;
     }
-    // Copy level with connections to one below
-    void copyLevel(const SkipList& other, int level)
+    // LEB128 varint, 7 bits per byte, low bits first
+    static void putVarint(std::string& out, std::uint64_t value)
     {
-        SkipNode<T>* other_curr = other.getHeadAtLevel(level)->right;
-        SkipNode<T>* current = getHeadAtLevel(level);
-        
-        while (other_curr != other.getTailAtLevel(level)) {
-            SkipNode<T>* new_node = create_node(other_curr->data);
-            
-            new_node->right = current->right;
-            new_node->left = current;
-            current->right->left = new_node;
-            current->right = new_node;
-            
-            if (level > 1) {
-                SkipNode<T>* lower_node = findLowerNode(new_node->data, level-1);
-                new_node->down = lower_node;
-            }
-            
-            other_curr = other_curr->right;
-            current = current->right;
-        }
-    }
-    // Find the lower node
-    SkipNode<T>* findLowerNode(const T& data, int level)
-    {
-        SkipNode<T>* current = getHeadAtLevel(level)->right;
-        
-        if (!current || !current->right)
+        for (; value >= 0x80; value >>= 7)
         {
-            std::cerr << "Invalid node traversal!" << std::endl;
-            return nullptr;
+            out.push_back(static_cast<char>(value | 0x80));
         }
-        
-        SkipNode<T>* level_tail = getTailAtLevel(level);
-        while (current && current != level_tail && _comp(current->data, data))
+        out.push_back(static_cast<char>(value));
+    }
+    static std::uint64_t getVarint(std::streambuf& in)
+    {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
         {
-            current = current->right;
+            auto byte = in.sbumpc();
+            if (byte == std::streambuf::traits_type::eof())
+            {
+                throw std::invalid_argument("load: truncated stream");
+            }
+            value |= std::uint64_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
         }
-        return current ? current : nullptr;
+        throw std::invalid_argument("load: malformed varint");
     }
-    // Finds a node with given key (used by find(), contains(), etc.)
-    /*
-     * Search Algorithm:
-     * 1. Start at top-left (head of highest level)
-     * 2. While not at bottom level:
-     *    a. Move right while next node's value < search key
-     *    b. Move down one level
-     * 3. At bottom level, check if next node matches key
-     * 4. Return node if found, nullptr otherwise
-     */
-    template <typename K>
-    SkipNode<T>* findNode(const K& key) const
+    static void getBytes(std::streambuf& in, void* dest, size_t bytes)
     {
-        SkipNode<T>* current_node = head;
-        if (!current_node || !current_node->right)
+        if (static_cast<size_t>(in.sgetn(static_cast<char*>(dest), static_cast<std::streamsize>(bytes))) != bytes)
         {
-            std::cerr << "Invalid node traversal!" << std::endl;
-            return nullptr;
+            throw std::invalid_argument("load: truncated stream");
         }
-        for (int l = current_max_level; l >= 1; --l)
+    }
+    // Appends one element; prev carries the previous integer key between calls
+    static void putValue(std::string& out, const T& value, [[maybe_unused]] bool varint, [[maybe_unused]] std::uint64_t& prev)
+    {
+        if constexpr (varint_codable)
         {
-            SkipNode<T>* current_tail = getTailAtLevel(l);
-            while (current_node->right != current_tail && _comp(current_node->right->data, key))
+            if (varint)
             {
-                current_node = current_node->right;
+                // Zigzag keeps small differences short in either direction
+                using U = std::make_unsigned_t<T>;
+                const U delta = static_cast<U>(static_cast<U>(value) - static_cast<U>(prev));
+                prev = static_cast<U>(value);
+                putVarint(out, static_cast<U>(static_cast<U>(delta << 1) ^ static_cast<U>(0 - static_cast<U>(delta >> (std::numeric_limits<U>::digits - 1)))));
+                return;
             }
-            if (current_node->right != current_tail && !_comp(key, current_node->right->data) && !_comp(current_node->right->data, key))
+        }
+        if constexpr (length_codable && !std::is_trivially_copyable_v<T>)
+        {
+            const size_t length = std::ranges::size(value);
+            putVarint(out, length);
+            out.append(reinterpret_cast<const char*>(std::ranges::data(value)), length * sizeof(std::ranges::range_value_t<T>));
+        }else
+        {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "save/load need integral, trivially copyable or contiguous container (std::string) elements");
+            out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+    }
+    static T getValue(std::streambuf& in, [[maybe_unused]] bool varint, [[maybe_unused]] std::uint64_t& prev)
+    {
+        if constexpr (varint_codable)
+        {
+            if (varint)
             {
-                return current_node->right;
+                using U = std::make_unsigned_t<T>;
+                const std::uint64_t zigzag = getVarint(in);
+                if (zigzag > std::numeric_limits<U>::max())
+                {
+                    throw std::invalid_argument("load: key out of range");
+                }
+                const U encoded = static_cast<U>(zigzag);
+                const U delta = static_cast<U>(static_cast<U>(encoded >> 1) ^ static_cast<U>(0 - static_cast<U>(encoded & 1)));
+                prev = static_cast<U>(static_cast<U>(prev) + delta);
+                return static_cast<T>(static_cast<U>(prev));
             }
-            current_node = current_node->down;
         }
-        return nullptr;
+        if constexpr (length_codable && !std::is_trivially_copyable_v<T>)
+        {
+            T value;
+            value.resize(getVarint(in));
+            getBytes(in, std::ranges::data(value), std::ranges::size(value) * sizeof(std::ranges::range_value_t<T>));
+            return value;
+        }else
+        {
+            T value;
+            getBytes(in, &value, sizeof(T));
+            return value;
+        }
     }
-    // Internal erase implementation - removes node from all levels
-    void eraseNode(SkipNode<T>* node)
+    // Points every level of head straight at tail
+    void resetHead() noexcept
+    {
+        for (int l = 1; l <= MAX_LVL; ++l)
+        {
+            head->next(l) = tail;
+            if constexpr (indexable) head->width(l) = 1;
+        }
+        tail->left = head;
+        _finger_valid = false;
+    }
+    // Frees every tower including sentinels
+    void destroyAll() noexcept
+    {
+        if constexpr (persistent)
+        {
+            // The saved list keeps its towers; only its size and height are written back
+            SkipListRoot& root = *_node_alloc.root();
+            if (root.head == head)
+            {
+                root.size = _size;
+                root.current_max_level = current_max_level;
+                root.attached = false;
+                head = tail = nullptr;
+                return;
+            }
+        }
+        [[maybe_unused]] bool release_in_bulk = false;
+        if constexpr (bulk_release)
+        {
+            // The arena reclaims all towers at once when its last owner goes away. Only
+            // _alloc and _node_alloc left means that is this list; while other lists
+            // (split halves, user copies) share the arena, towers go back to its free lists
+            release_in_bulk = _node_alloc.use_count() <= 2;
+            if (release_in_bulk && std::is_trivially_destructible_v<T>)
+            {
+                head = tail = nullptr;
+                return;
+            }
+        }
+        SkipNode<T>* current_node = head;
+        while (current_node != nullptr) {
+            SkipNode<T>* next_node = (current_node == tail) ? nullptr : current_node->next(1);
+            if (release_in_bulk)
+            {
+                std::allocator_traits<node_allocator>::destroy(_node_alloc, current_node);
+            }else
+            {
+                delete_node(current_node);
+            }
+            current_node = next_node;
+        }
+        head = tail = nullptr;
+    }
+    // Wraps a value for diagnostics; types without operator<< print as "?"
+    struct Printable
+    {
+        const T& value;
+        friend std::ostream& operator<<(std::ostream& os, const Printable& p)
+        {
+            if constexpr (requires { os << p.value; }) return os << p.value;
+            else return os << '?';
+        }
+    };
+    static Printable printable(const T& value) noexcept { return Printable{value}; }
+    // Frees towers from node up to the tail sentinel along the bottom level
+    void freeChain(SkipNode<T>* node) noexcept
     {
-        while (node) {
-            SkipNode<T>* next_level = node->down;
-            
-            if (node->left) node->left->right = node->right;  
-            if (node->right) node->right->left = node->left;  
-            
+        while (node != tail)
+        {
+            SkipNode<T>* next_node = node->next(1);
             delete_node(node);
-            node = next_level;
+            node = next_node;
         }
-        --_size;
-
-        trimEmptyLevels();
-        
-        if (!validate()) {
-            std::cerr << "Structure corrupted after erase!" << std::endl;
+    }
+    // Adds n to a hot-path counter of stats(); compiled out unless SKIPLIST_STATS
+    void tally([[maybe_unused]] size_t SkipListStats::* counter, [[maybe_unused]] size_t n = 1) const noexcept
+    {
+#if SKIPLIST_STATS
+        std::atomic_ref<size_t>(_counters.*counter).fetch_add(n, std::memory_order_relaxed);
+#endif
+    }
+    // Accounts for one descent from head that followed steps links
+    void countSearch(size_t steps, size_t comparisons) const noexcept
+    {
+        tally(&SkipListStats::searches);
+        tally(&SkipListStats::search_steps, steps);
+        tally(&SkipListStats::comparisons, comparisons);
+    }
+    // Generates a random level for new nodes (geometric distribution)
+    int random_level()
+    {
+        return _level_gen(MAX_LVL);
+    }
+    // Shared insert path: one descent by key, then the tower is built from args
+    // (behind the equivalents of key if the list allows them)
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> insertUnique(const K& key, Args&&... args)
+    {
+        predecessor_path update;
+        search_rank rank;
+        if constexpr (multi)
+        {
+            findLastPredecessors(key, update.data(), rank.data());
+            SkipNode<T>* new_node = create_node(random_level(), std::forward<Args>(args)...);
+            linkTower(new_node, update.data(), rank.data());
+            return {iterator(new_node, tail), true};
         }
+        SkipNode<T>* successor = findPredecessors(key, update.data(), rank.data());
+        if (successor != tail && !_comp(key, successor->data))
+        {
+            return {iterator(successor, tail), false};
+        }
+
+        SkipNode<T>* new_node = create_node(random_level(), std::forward<Args>(args)...);
+        linkTower(new_node, update.data(), rank.data());
+        return {iterator(new_node, tail), true};
     }
-    // Removes empty top levels after erasures
-    void trimEmptyLevels()
+    // Shared hinted insert path, see insert(const_iterator, const T&)
+    template <typename K, typename... Args>
+    iterator insertHint(const_iterator hint, const K& key, Args&&... args)
     {
-        while(current_max_level > 1 && head->right == tail)
+        if constexpr (indexable)
+        {
+            // Widths need the rank of every predecessor, which only a descent provides
+            return insertUnique(key, std::forward<Args>(args)...).first;
+        }
+        SkipNode<T>* successor = const_cast<SkipNode<T>*>(hint.current);
+        SkipNode<T>* predecessor = successor->left;
+        if constexpr (multi)
+        {
+            // Any hint between the equivalents of key is taken as is
+            if ((predecessor != head && _comp(key, predecessor->data)) ||
+                (successor != tail && _comp(successor->data, key)))
+            {
+                return insertUnique(key, std::forward<Args>(args)...).first;
+            }
+        }else
         {
-            SkipNode<T>* old_head = head;
-            SkipNode<T>* old_tail = tail;
-            
-            head = head->down;
-            tail = tail->down;
-            
-            delete_node(old_head);
-            delete_node(old_tail);
+            if (predecessor != head && !_comp(predecessor->data, key))
+            {
+                if (!_comp(key, predecessor->data)) return iterator(predecessor, tail);
+                return insertUnique(key, std::forward<Args>(args)...).first;
+            }
+            if (successor != tail && !_comp(key, successor->data))
+            {
+                if (!_comp(successor->data, key)) return iterator(successor, tail);
+                return insertUnique(key, std::forward<Args>(args)...).first;
+            }
+        }
 
-            --current_max_level;
+        SkipNode<T>* new_node = create_node(random_level(), std::forward<Args>(args)...);
+        predecessor_path update;
+        collectPredecessorsLeft(predecessor, new_node->height, update.data());
+        linkTower(new_node, update.data(), nullptr);
+        _finger_valid = false;
+        return iterator(new_node, tail);
+    }
+    // Mean links a descent from head follows to reach an element
+    /*
+     * A descent reaches a tower of height h along level h, one link after the
+     * nearest tower to its left that is at least as tall (head if none), so
+     * the cost of every tower follows from the costs last seen on each level.
+     */
+    double expectedPathLength() const noexcept
+    {
+        if (_size == 0) return 0.0;
+        std::array<size_t, MAX_LVL + 1> last{};
+        size_t total = 0;
+        for (const SkipNode<T>* node = head->next(1); node != tail; node = node->next(1))
+        {
+            size_t steps = last[node->height] + 1;
+            for (int l = 1; l <= node->height; ++l) last[l] = steps;
+            total += steps;
         }
+        return static_cast<double>(total) / _size;
     }
-    // Validates that an iterator points to a valid element
-    bool validate_iterator(const_iterator it) const
+    // Height of the index-th (1-based) element in a perfectly balanced list
+    int balanced_level(size_t index) const noexcept
+    {
+        double p = _level_gen.promotion_probability();
+        int level = 1;
+        if (p == SkipLevelGenerator::HALF)
+        {
+            level += std::countr_zero(index);
+        }else
+        {
+            size_t step = static_cast<size_t>(std::lround(1.0 / p));
+            for (; step > 1 && index % step == 0; index /= step) ++level;
+        }
+        return level < MAX_LVL ? level : MAX_LVL;
+    }
+    // Links new_node after update[l] on each of its levels and accounts for it;
+    // indexable lists also need rank[l], the position of update[l] (head is 0)
+    void linkTower(SkipNode<T>* new_node, SkipNode<T>** update, [[maybe_unused]] const size_t* rank) noexcept
     {
-        for (auto curr = begin(); curr != end(); ++curr) {
-            if (curr == it) return true;
+        if (new_node->height > current_max_level)
+        {
+            current_max_level = new_node->height;
+            tally(&SkipListStats::level_growths);
         }
-        return false;
+        for (int l = 1; l <= new_node->height; ++l)
+        {
+            new_node->next(l) = update[l]->next(l);
+            update[l]->next(l) = new_node;
+        }
+        if constexpr (indexable)
+        {
+            // The links of update[l] are split around the new position; higher links lengthen by one
+            size_t position = rank[1] + 1;
+            for (int l = 1; l <= new_node->height; ++l)
+            {
+                new_node->width(l) = rank[l] + update[l]->width(l) + 1 - position;
+                update[l]->width(l) = position - rank[l];
+            }
+            for (int l = new_node->height + 1; l <= MAX_LVL; ++l)
+            {
+                ++update[l]->width(l);
+            }
+        }
+        new_node->left = update[1];
+        new_node->next(1)->left = new_node;
+        ++_size;
     }
-};
+    // Links new_node at the end of the list; last[l] is the rightmost tower of level l
+    void appendTower(SkipNode<T>* new_node, SkipNode<T>** last) noexcept
+    {
+        if constexpr (indexable)
+        {
+            // last[l] links straight to the tail, which sits at position size + 1
+            search_rank rank{};
+            for (int l = 1; l <= new_node->height; ++l)
+            {
+                rank[l] = _size + 1 - last[l]->width(l);
+            }
+            linkTower(new_node, last, rank.data());
+        }else
+        {
+            linkTower(new_node, last, nullptr);
+        }
+        for (int l = 1; l <= new_node->height; ++l)
+        {
+            last[l] = new_node;
+        }
+        _finger_valid = false;
+    }
+    // Fills update[1..height] with the nearest towers at or left of node tall enough
+    // for each level, walking the bottom level leftwards (head spans every level)
+    void collectPredecessorsLeft(SkipNode<T>* node, int height, SkipNode<T>** update) const noexcept
+    {
+        for (int l = 1; l <= height; ++l)
+        {
+            while (node != head && node->height < l)
+            {
+                node = node->left;
+            }
+            update[l] = node;
+        }
+    }
+    // Records in update[l] the last tower preceding key on every used level
+    // (and its position in rank[l] for indexable lists, if rank is given)
+    // and returns the first tower not less than key on the bottom level
+    template <typename K>
+    SkipNode<T>* findPredecessors(const K& key, SkipNode<T>** update, [[maybe_unused]] size_t* rank = nullptr) const
+    {
+        if (fingerActive() && _finger_valid) return fingerPredecessors(key, update);
+        SkipNode<T>* current_node = head;
+        [[maybe_unused]] size_t position = 0;
+        size_t steps = 0;
+        size_t stops = 0;
+        for (int l = current_max_level; l >= 1; --l)
+        {
+            SkipNode<T>* next_node = current_node->next(l);
+            while (next_node != tail && _comp(next_node->data, key))
+            {
+                if constexpr (indexable) position += current_node->width(l);
+                current_node = next_node;
+                next_node = current_node->next(l);
+                ++steps;
+            }
+            stops += next_node != tail;
+            update[l] = current_node;
+            if constexpr (indexable)
+            {
+                if (rank) rank[l] = position;
+            }
+        }
+        std::fill(update + current_max_level + 1, update + MAX_LVL + 1, head);
+        if constexpr (indexable)
+        {
+            if (rank) std::fill(rank + current_max_level + 1, rank + MAX_LVL + 1, 0);
+        }
+        countSearch(steps, steps + stops);
+        if (fingerActive()) saveFinger(update);
+        return current_node->next(1);
+    }
+    // Like findPredecessors, but for the tower node itself rather than its key
+    /*
+     * With equivalent keys the descent stops in front of all of them, so the nearest
+     * equivalent towers left of node take over the levels they reach.
+     */
+    void findNodePredecessors(SkipNode<T>* node, SkipNode<T>** update, [[maybe_unused]] size_t* rank = nullptr) const
+    {
+        findPredecessors(node->data, update, rank);
+        if constexpr (multi)
+        {
+            auto equivalent = [&](const SkipNode<T>* before) { return before != head && !_comp(before->data, node->data); };
+            [[maybe_unused]] size_t position = 0;
+            if constexpr (indexable)
+            {
+                // Position of node: behind the last smaller tower and every equivalent
+                position = rank ? rank[1] + 1 : 0;
+                for (const SkipNode<T>* before = node->left; rank && equivalent(before); before = before->left) ++position;
+            }
+            int filled = 0;
+            for (SkipNode<T>* before = node->left; equivalent(before) && filled < current_max_level; before = before->left)
+            {
+                if constexpr (indexable) --position;
+                while (filled < before->height)
+                {
+                    update[++filled] = before;
+                    if constexpr (indexable)
+                    {
+                        if (rank) rank[filled] = position;
+                    }
+                }
+            }
+        }
+    }
+    // Like findPredecessors, but update[l] is the last tower not greater than key
+    // and the first tower greater than key is returned; the finger is invalidated
+    template <typename K>
+    SkipNode<T>* findLastPredecessors(const K& key, SkipNode<T>** update, [[maybe_unused]] size_t* rank = nullptr) const
+    {
+        SkipNode<T>* current_node = head;
+        [[maybe_unused]] size_t position = 0;
+        size_t steps = 0;
+        size_t stops = 0;
+        for (int l = current_max_level; l >= 1; --l)
+        {
+            SkipNode<T>* next_node = current_node->next(l);
+            while (next_node != tail && !_comp(key, next_node->data))
+            {
+                if constexpr (indexable) position += current_node->width(l);
+                current_node = next_node;
+                next_node = current_node->next(l);
+                ++steps;
+            }
+            stops += next_node != tail;
+            update[l] = current_node;
+            if constexpr (indexable)
+            {
+                if (rank) rank[l] = position;
+            }
+        }
+        std::fill(update + current_max_level + 1, update + MAX_LVL + 1, head);
+        if constexpr (indexable)
+        {
+            if (rank) std::fill(rank + current_max_level + 1, rank + MAX_LVL + 1, 0);
+        }
+        countSearch(steps, steps + stops);
+        _finger_valid = false;
+        return current_node->next(1);
+    }
+    // First tower not less than key
+    template <typename K>
+    SkipNode<T>* lowerBoundNode(const K& key) const
+    {
+        if (fingerActive())
+        {
+            predecessor_path update;
+            return findPredecessors(key, update.data());
+        }
+        SkipNode<T>* node = head;
+        size_t steps = 0;
+        size_t stops = 0;
+        for(int lvl = current_max_level; lvl >= 1; --lvl)
+        {
+            while(node->next(lvl) != tail && _comp(node->next(lvl)->data, key))
+            {
+                node = node->next(lvl);
+                ++steps;
+            }
+            stops += node->next(lvl) != tail;
+        }
+        countSearch(steps, steps + stops);
+        return node->next(1);
+    }
+    // First tower at or after node that is greater than key
+    template <typename K>
+    SkipNode<T>* pastEquivalents(SkipNode<T>* node, const K& key) const
+    {
+        while (node != tail && !_comp(key, node->data))
+        {
+            node = node->next(1);
+        }
+        return node;
+    }
+    // First tower greater than key
+    template <typename K>
+    SkipNode<T>* upperBoundNode(const K& key) const
+    {
+        if constexpr (multi)
+        {
+            predecessor_path update;
+            return findLastPredecessors(key, update.data());
+        }
+        SkipNode<T>* node = lowerBoundNode(key);
+        return (node != tail && !_comp(key, node->data)) ? node->next(1) : node;
+    }
+    // Moves a search path exact for the previous key (path[l] below it, path[l]->next(l)
+    // not) to key and returns the first tower not less than key
+    /*
+     * Climb while the remembered predecessor is not below key (key moved back) or the
+     * next tower one level up still is (key moved forward), then descend as usual.
+     * Levels above the climb need no search: a path exact for the previous key stays
+     * exact there for every key between the two. An all-head path is exact for a key
+     * below every element.
+     */
+    template <typename K>
+    SkipNode<T>* climbPath(const K& key, SkipNode<T>** path) const
+    {
+        auto before_key = [&](const SkipNode<T>* node) { return node == head || _comp(node->data, key); };
+        int level = 1;
+        while (level < current_max_level && !before_key(path[level])) ++level;
+        SkipNode<T>* current_node = head;
+        if (before_key(path[level]))
+        {
+            while (level < current_max_level && below(path[level + 1]->next(level + 1), key)) ++level;
+            current_node = path[level];
+        }
+        for (int l = level; l >= 1; --l)
+        {
+            while (below(current_node->next(l), key))
+            {
+                current_node = current_node->next(l);
+            }
+            path[l] = current_node;
+        }
+        std::fill(path + current_max_level + 1, path + MAX_LVL + 1, head);
+        return current_node->next(1);
+    }
+    // Finger search: the path of the previous search is climbed to key (see use_finger)
+    template <typename K>
+    SkipNode<T>* fingerPredecessors(const K& key, SkipNode<T>** update) const
+    {
+        SkipNode<T>* successor = climbPath(key, _finger.data());
+        std::copy(_finger.begin(), _finger.begin() + MAX_LVL + 1, update);
+        return successor;
+    }
+    // Remembers an exact search path for the next finger search
+    void saveFinger(SkipNode<T>* const* update) const noexcept
+    {
+        std::copy(update, update + MAX_LVL + 1, _finger.begin());
+        _finger_valid = true;
+    }
+    bool fingerActive() const noexcept
+    {
+        if constexpr (indexable) return false;
+        else return _finger_enabled;
+    }
+    // True if node is an element ordered before key (sentinels never are)
+    template <typename K>
+    bool below(const SkipNode<T>* node, const K& key) const
+    {
+        return node != tail && node != head && _comp(node->data, key);
+    }
+    // First tower not less than key, searched forward from start (head or a tower below key)
+    /*
+     * Climb the towers met on the way while a higher link still stays below key,
+     * then descend as usual: O(log d) expected steps for a key d elements ahead.
+     */
+    template <typename K>
+    SkipNode<T>* lowerBoundFrom(SkipNode<T>* start, const K& key) const
+    {
+        SkipNode<T>* current_node = start;
+        int level = 1;
+        while (true)
+        {
+            int top = std::min(current_node->height, current_max_level);
+            while (level < top && below(current_node->next(level + 1), key)) ++level;
+            if (!below(current_node->next(level), key)) break;
+            current_node = current_node->next(level);
+        }
+        for (int l = level - 1; l >= 1; --l)
+        {
+            while (below(current_node->next(l), key))
+            {
+                current_node = current_node->next(l);
+            }
+        }
+        return current_node->next(1);
+    }
+    // Shared batch path: sorted sweep with reused search paths, emit turns a tower
+    // (nullptr if absent) into the value written for each probe
+    template <typename ForwardIt, typename OutputIt, typename Emit>
+    OutputIt batchLookup(ForwardIt first, ForwardIt last, OutputIt out, Emit emit) const
+    {
+        using Key = typename std::iterator_traits<ForwardIt>::value_type;
+        std::vector<const Key*> probes;
+        for (; first != last; ++first)
+        {
+            probes.push_back(&*first);
+        }
+        std::vector<size_t> order(probes.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        auto probe_less = [&](size_t a, size_t b) { return _comp(*probes[a], *probes[b]); };
+        if (!std::is_sorted(order.begin(), order.end(), probe_less))
+        {
+            std::sort(order.begin(), order.end(), probe_less);
+        }
+
+        std::vector<SkipNode<T>*> found(probes.size());
+        if (_size < BATCH_INTERLEAVE_MIN)
+        {
+            predecessor_path path;
+            path.fill(head);
+            for (size_t i : order)
+            {
+                const Key& key = *probes[i];
+                SkipNode<T>* successor = climbPath(key, path.data());
+                found[i] = (successor != tail && !_comp(key, successor->data)) ? successor : nullptr;
+            }
+        }else
+        {
+            interleavedLookup(probes, order, found);
+        }
+        for (SkipNode<T>* node : found)
+        {
+            *out++ = emit(node);
+        }
+        return out;
+    }
+    // Lists at least this long take the interleaved batch path; below it the nodes
+    // mostly sit in cache and a single sweep is cheaper
+    static constexpr size_t BATCH_INTERLEAVE_MIN = size_t(1) << 16;
+    // Searches advanced in lockstep by interleavedLookup
+    static constexpr size_t BATCH_LANES = 16;
+    static void prefetch(const void* address) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        (void)address;
+#endif
+    }
+    // Sorted probes split into BATCH_LANES contiguous runs, each swept like batchLookup
+    /*
+     * Every lane keeps its own search path and makes one step (climb one level, move
+     * right or drop a level) per round, prefetching the tower it will compare next.
+     * By the time a lane comes round again its cache miss has been served, so up to
+     * BATCH_LANES misses are in flight instead of one.
+     */
+    template <typename Key>
+    void interleavedLookup(const std::vector<const Key*>& probes, const std::vector<size_t>& order,
+                           std::vector<SkipNode<T>*>& found) const
+    {
+        struct Lane
+        {
+            predecessor_path path;
+            SkipNode<T>* node;
+            int level;
+            bool climbing;
+            size_t cursor;
+            size_t end;
+        };
+        std::array<Lane, BATCH_LANES> lanes;
+        auto restart = [&](Lane& lane)
+        {
+            lane.level = 1;
+            lane.climbing = true;
+            if (current_max_level > 1) prefetch(lane.path[2]->next(2));
+        };
+        size_t active = 0;
+        size_t run = (order.size() + BATCH_LANES - 1) / BATCH_LANES;
+        for (size_t from = 0; from < order.size(); from += run)
+        {
+            Lane& lane = lanes[active++];
+            lane.path.fill(head);
+            lane.cursor = from;
+            lane.end = std::min(order.size(), from + run);
+            restart(lane);
+        }
+        while (active > 0)
+        {
+            for (size_t i = 0; i < active; ++i)
+            {
+                Lane& lane = lanes[i];
+                const Key& key = *probes[order[lane.cursor]];
+                if (lane.climbing)
+                {
+                    if (lane.level < current_max_level && below(lane.path[lane.level + 1]->next(lane.level + 1), key))
+                    {
+                        ++lane.level;
+                        if (lane.level < current_max_level) prefetch(lane.path[lane.level + 1]->next(lane.level + 1));
+                    }else
+                    {
+                        lane.climbing = false;
+                        lane.node = lane.path[lane.level];
+                        prefetch(lane.node->next(lane.level));
+                    }
+                    continue;
+                }
+                SkipNode<T>* next_node = lane.node->next(lane.level);
+                if (below(next_node, key))
+                {
+                    lane.node = next_node;
+                    prefetch(next_node->next(lane.level));
+                    continue;
+                }
+                lane.path[lane.level] = lane.node;
+                if (lane.level > 1)
+                {
+                    --lane.level;
+                    prefetch(lane.node->next(lane.level));
+                    continue;
+                }
+                found[order[lane.cursor]] = (next_node != tail && !_comp(key, next_node->data)) ? next_node : nullptr;
+                if (++lane.cursor < lane.end)
+                {
+                    restart(lane);
+                }else
+                {
+                    // Finished lane: the last one takes its slot and runs in this round
+                    lane = lanes[--active];
+                    --i;
+                }
+            }
+        }
+    }
+    // Start of a forward search for key near hint: hint, its left neighbour or head
+    template <typename K>
+    SkipNode<T>* hintStart(const_iterator hint, const K& key) const
+    {
+        SkipNode<T>* node = const_cast<SkipNode<T>*>(hint.current);
+        if (node == tail || !_comp(node->data, key)) node = node->left;
+        if (node != head && !_comp(node->data, key)) return head;
+        return node;
+    }
+    // Finds a node with given key (used by find(), contains(), etc.)
+    /*
+     * Search Algorithm:
+     * 1. Start at head on the highest used level
+     * 2. For each level from top to bottom:
+     *    a. Move right while next tower's value < search key
+     *    b. If next tower matches key return it
+     *    c. Drop one level within the same tower
+     * 3. Return nullptr if no level matched
+     */
+    template <typename K>
+    SkipNode<T>* findNode(const K& key) const
+    {
+        if (fingerActive())
+        {
+            predecessor_path update;
+            SkipNode<T>* successor = findPredecessors(key, update.data());
+            return (successor != tail && !_comp(key, successor->data)) ? successor : nullptr;
+        }
+        SkipNode<T>* current_node = head;
+        size_t steps = 0;
+        size_t stops = 0;
+        for (int l = current_max_level; l >= 1; --l)
+        {
+            SkipNode<T>* next_node = current_node->next(l);
+            while (next_node != tail && _comp(next_node->data, key))
+            {
+                current_node = next_node;
+                next_node = current_node->next(l);
+                ++steps;
+            }
+            if (next_node != tail && !_comp(key, next_node->data))
+            {
+                countSearch(steps, steps + 2 * stops + 2);
+                return next_node;
+            }
+            stops += next_node != tail;
+        }
+        countSearch(steps, steps + 2 * stops);
+        return nullptr;
+    }
+    // Internal erase implementation - unlinks the tower from all its levels
+    void eraseNode(SkipNode<T>* node)
+    {
+        predecessor_path update;
+        findNodePredecessors(node, update.data());
+        for (int l = 1; l <= node->height; ++l)
+        {
+            update[l]->next(l) = node->next(l);
+        }
+        if constexpr (indexable)
+        {
+            for (int l = 1; l <= node->height; ++l)
+            {
+                update[l]->width(l) += node->width(l) - 1;
+            }
+            for (int l = node->height + 1; l <= MAX_LVL; ++l)
+            {
+                --update[l]->width(l);
+            }
+        }
+        node->next(1)->left = node->left;
+        delete_node(node);
+        --_size;
+
+        trimEmptyLevels();
+        
+        if constexpr (debug_checks)
+        {
+            if (!validate()) {
+                std::cerr << "Structure corrupted after erase!" << std::endl;
+            }
+        }
+    }
+    // Workers for a parallel operation over n elements: policy.threads or one per
+    // hardware thread, but at least parallel_grain elements each
+    static size_t workersFor(parallel_t policy, size_t n) noexcept
+    {
+        size_t threads = policy.threads ? policy.threads : std::max(1u, std::thread::hardware_concurrency());
+        return std::max<size_t>(1, std::min(threads, n / parallel_grain));
+    }
+    // Runs work(0..count-1) on count threads, the calling one included, and rethrows
+    // the first exception once all of them are done
+    template <typename Work>
+    static void runWorkers(size_t count, Work work)
+    {
+        std::vector<std::exception_ptr> errors(count);
+        auto run = [&](size_t c)
+        {
+            try
+            {
+                work(c);
+            }catch(...)
+            {
+                errors[c] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(count);
+        size_t c = 1;
+        try
+        {
+            for (; c < count; ++c) workers.emplace_back(run, c);
+        }catch(...)
+        {
+            // Out of threads: the rest runs here
+            for (; c < count; ++c) run(c);
+        }
+        run(0);
+        for (std::thread& worker : workers) worker.join();
+        for (std::exception_ptr& error : errors)
+        {
+            if (error) std::rethrow_exception(error);
+        }
+    }
+    // Links node behind the towers of a chunk; next(l) of the last towers and left of
+    // the first one are set when the chunks are stitched
+    void chainTower(chunk_chain& chain, SkipNode<T>* node) const noexcept
+    {
+        ++chain.count;
+        chain.units += node_units(node->height);
+        chain.height = std::max(chain.height, node->height);
+        node->left = chain.last[1];
+        for (int l = 1; l <= node->height; ++l)
+        {
+            if (chain.last[l])
+            {
+                chain.last[l]->next(l) = node;
+                if constexpr (indexable) chain.last[l]->width(l) = chain.count - chain.last_pos[l];
+            }else
+            {
+                chain.first[l] = node;
+                chain.first_pos[l] = chain.count;
+            }
+            chain.last[l] = node;
+            chain.last_pos[l] = chain.count;
+        }
+    }
+    // Fills the empty list from chunks built by build(c, chain) on separate threads,
+    // then links the chains in order
+    template <typename Build>
+    void buildChunks(size_t chunks, Build build)
+    {
+        std::vector<chunk_chain> chains(chunks);
+        std::exception_ptr error;
+        try
+        {
+            runWorkers(chunks, [&](size_t c) { build(c, chains[c]); });
+        }catch(...)
+        {
+            error = std::current_exception();
+        }
+        predecessor_path last;
+        last.fill(head);
+        search_rank last_pos{};
+        for (chunk_chain& chain : chains)
+        {
+            tally(&SkipListStats::nodes_allocated, chain.count);
+            tally(&SkipListStats::bytes_allocated, chain.units * sizeof(SkipNodeWord<T>));
+            if (!chain.count) continue;
+            chain.first[1]->left = last[1];
+            for (int l = 1; l <= chain.height; ++l)
+            {
+                if (!chain.first[l]) continue;
+                last[l]->next(l) = chain.first[l];
+                if constexpr (indexable) last[l]->width(l) = _size + chain.first_pos[l] - last_pos[l];
+                last[l] = chain.last[l];
+                last_pos[l] = _size + chain.last_pos[l];
+            }
+            _size += chain.count;
+            current_max_level = std::max(current_max_level, chain.height);
+        }
+        for (int l = 1; l <= MAX_LVL; ++l)
+        {
+            last[l]->next(l) = tail;
+            if constexpr (indexable) last[l]->width(l) = _size + 1 - last_pos[l];
+        }
+        tail->left = last[1];
+        _finger_valid = false;
+        if (error)
+        {
+            clear();
+            std::rethrow_exception(error);
+        }
+    }
+    // Splits the bottom level into at most parts runs of similar length at the towers
+    // of the highest level with at least four per run (the bottom level if none has);
+    // returns the run boundaries, head->next(1) first and tail last
+    std::vector<SkipNode<T>*> partitionTowers(size_t parts) const
+    {
+        int level = current_max_level;
+        size_t towers = 0;
+        for (; level >= 1; --level)
+        {
+            towers = 0;
+            for (const SkipNode<T>* node = head->next(level); node != tail; node = node->next(level)) ++towers;
+            if (towers >= 4 * parts || level == 1) break;
+        }
+        parts = std::max<size_t>(1, std::min(parts, towers));
+        std::vector<SkipNode<T>*> bounds{head->next(1)};
+        SkipNode<T>* node = head->next(level);
+        for (size_t index = 0, part = 1; part < parts; node = node->next(level), ++index)
+        {
+            if (index == towers * part / parts)
+            {
+                bounds.push_back(node);
+                ++part;
+            }
+        }
+        bounds.push_back(tail);
+        return bounds;
+    }
+    // Calls visit on every tower, one run of the bottom level per worker
+    template <typename Visit>
+    void forEachRun(parallel_t policy, Visit visit) const
+    {
+        std::vector<SkipNode<T>*> bounds = partitionTowers(workersFor(policy, _size));
+        runWorkers(bounds.size() - 1, [&](size_t c)
+        {
+            for (SkipNode<T>* node = bounds[c]; node != bounds[c + 1]; node = node->next(1)) visit(node);
+        });
+    }
+    // combine with both lists cut at the first element not less than each boundary key
+    static SkipList combineParallel(parallel_t policy, const SkipList& lsl, const SkipList& rsl,
+                                    bool only_left, bool both, bool only_right)
+    {
+        const SkipList& larger = lsl.size() >= rsl.size() ? lsl : rsl;
+        const size_t chunks = parallel_alloc ? workersFor(policy, lsl.size() + rsl.size()) : 1;
+        if (chunks == 1) return combine(lsl, rsl, only_left, both, only_right);
+        std::vector<SkipNode<T>*> keys = larger.partitionTowers(chunks);
+        std::vector<const SkipNode<T>*> left_bounds{lsl.head->next(1)};
+        std::vector<const SkipNode<T>*> right_bounds{rsl.head->next(1)};
+        for (size_t c = 1; c + 1 < keys.size(); ++c)
+        {
+            left_bounds.push_back(lsl.lowerBoundNode(keys[c]->data));
+            right_bounds.push_back(rsl.lowerBoundNode(keys[c]->data));
+        }
+        left_bounds.push_back(lsl.tail);
+        right_bounds.push_back(rsl.tail);
+
+        SkipList result(fresh_list_t{}, lsl._comp,
+                        std::allocator_traits<Allocator>::select_on_container_copy_construction(lsl._alloc));
+        result._level_gen = lsl._level_gen;
+        result._finger_enabled = lsl._finger_enabled;
+        result.buildChunks(keys.size() - 1, [&](size_t c, chunk_chain& chain)
+        {
+            auto append = [&](const SkipNode<T>* node) { result.chainTower(chain, result.allocate_node(node->height, node->data)); };
+            const SkipNode<T>* left = left_bounds[c];
+            const SkipNode<T>* right = right_bounds[c];
+            while (left != left_bounds[c + 1] && right != right_bounds[c + 1])
+            {
+                if (lsl._comp(left->data, right->data))
+                {
+                    if (only_left) append(left);
+                    left = left->next(1);
+                }else if (lsl._comp(right->data, left->data))
+                {
+                    if (only_right) append(right);
+                    right = right->next(1);
+                }else
+                {
+                    if (both) append(left);
+                    left = left->next(1);
+                    right = right->next(1);
+                }
+            }
+            for (; only_left && left != left_bounds[c + 1]; left = left->next(1)) append(left);
+            for (; only_right && right != right_bounds[c + 1]; right = right->next(1)) append(right);
+        });
+        return result;
+    }
+    // Shared set algebra sweep: keeps the elements only in lsl, in both lists and only
+    // in rsl as requested, copying each into a tower of the same height
+    static SkipList combine(const SkipList& lsl, const SkipList& rsl, bool only_left, bool both, bool only_right)
+    {
+        SkipList result(fresh_list_t{}, lsl._comp,
+                        std::allocator_traits<Allocator>::select_on_container_copy_construction(lsl._alloc));
+        result._level_gen = lsl._level_gen;
+        result._finger_enabled = lsl._finger_enabled;
+        predecessor_path last;
+        last.fill(result.head);
+        auto append = [&](const SkipNode<T>* node) { result.appendTower(result.create_node(node->height, node->data), last.data()); };
+        const SkipNode<T>* left = lsl.head->next(1);
+        const SkipNode<T>* right = rsl.head->next(1);
+        while (left != lsl.tail && right != rsl.tail)
+        {
+            if (lsl._comp(left->data, right->data))
+            {
+                if (only_left) append(left);
+                left = left->next(1);
+            }else if (lsl._comp(right->data, left->data))
+            {
+                if (only_right) append(right);
+                right = right->next(1);
+            }else
+            {
+                if (both) append(left);
+                left = left->next(1);
+                right = right->next(1);
+            }
+        }
+        for (; only_left && left != lsl.tail; left = left->next(1)) append(left);
+        for (; only_right && right != rsl.tail; right = right->next(1)) append(right);
+        return result;
+    }
+    // Unlinks and frees the towers from first up to (excluding) last
+    void eraseSpan(SkipNode<T>* first, SkipNode<T>* last)
+    {
+        predecessor_path update;
+        search_rank rank;
+        findNodePredecessors(first, update.data(), rank.data());
+        // First tower at or after last on every level and its position
+        predecessor_path after;
+        search_rank after_rank;
+        if (last == tail)
+        {
+            after.fill(tail);
+            after_rank.fill(_size + 1);
+        }else
+        {
+            predecessor_path before_last;
+            search_rank last_rank;
+            findNodePredecessors(last, before_last.data(), last_rank.data());
+            for (int l = 1; l <= MAX_LVL; ++l)
+            {
+                after[l] = before_last[l]->next(l);
+                if constexpr (indexable) after_rank[l] = last_rank[l] + before_last[l]->width(l);
+            }
+        }
+        if constexpr (indexable)
+        {
+            size_t erased = after_rank[1] - rank[1] - 1;
+            for (int l = 1; l <= MAX_LVL; ++l)
+            {
+                update[l]->width(l) = after_rank[l] - erased - rank[l];
+            }
+        }
+        for (int l = 1; l <= current_max_level; ++l)
+        {
+            update[l]->next(l) = after[l];
+        }
+        last->left = update[1];
+        while (first != last)
+        {
+            SkipNode<T>* next_node = first->next(1);
+            delete_node(first);
+            --_size;
+            first = next_node;
+        }
+        _finger_valid = false;
+
+        trimEmptyLevels();
+
+        if constexpr (debug_checks)
+        {
+            if (!validate()) {
+                std::cerr << "Structure corrupted after range erase!" << std::endl;
+            }
+        }
+    }
+    // Fills last[l] with the rightmost tower of every level (head on empty levels)
+    void collectLastTowers(SkipNode<T>** last) const noexcept
+    {
+        SkipNode<T>* current_node = head;
+        for (int l = current_max_level; l >= 1; --l)
+        {
+            while (current_node->next(l) != tail)
+            {
+                current_node = current_node->next(l);
+            }
+            last[l] = current_node;
+        }
+        std::fill(last + current_max_level + 1, last + MAX_LVL + 1, head);
+    }
+    // Number of elements before node, counted from whichever end is closer
+    size_t countBefore(const SkipNode<T>* node) const noexcept
+    {
+        const SkipNode<T>* back = node->left;
+        const SkipNode<T>* front = node;
+        size_t before = 0;
+        size_t from_node = 0;
+        while (true)
+        {
+            if (back == head) return before;
+            if (front == tail) return _size - from_node;
+            back = back->left;
+            ++before;
+            front = front->next(1);
+            ++from_node;
+        }
+    }
+    // Lowers current_max_level past empty top levels after erasures
+    void trimEmptyLevels()
+    {
+        while(current_max_level > 1 && head->next(current_max_level) == tail)
+        {
+            --current_max_level;
+            tally(&SkipListStats::level_trims);
+        }
+    }
+    // Tower at 1-based bottom position, tail if past the end (indexable lists only)
+    SkipNode<T>* nodeAt(size_t position) const
+    {
+        if (position > _size) return tail;
+        SkipNode<T>* current_node = head;
+        size_t reached = 0;
+        for (int l = current_max_level; l >= 1; --l)
+        {
+            while (reached + current_node->width(l) <= position)
+            {
+                reached += current_node->width(l);
+                current_node = current_node->next(l);
+            }
+        }
+        return current_node;
+    }
+    // Validates that an iterator points to a linked element of this list: O(1) for
+    // iterators made by this list, O(log n) for towers moved in by split or join,
+    // whose iterators still name the list they came from
+    bool validate_iterator(const_iterator it) const
+    {
+        const SkipNode<T>* node = it.current;
+        if (!node || node == head || node == tail) return false;
+        if (!node->left || node->left->next(1) != node || node->next(1)->left != node) return false;
+        return pos_owner(it) == tail || linksNode(node);
+    }
+    // Whether node is linked into this list: a descent by its key, then a walk over
+    // its equivalents on the bottom level
+    bool linksNode(const SkipNode<T>* node) const noexcept
+    {
+        const SkipNode<T>* current = head;
+        for (int lvl = current_max_level; lvl >= 1; --lvl)
+        {
+            while (current->next(lvl) != tail && _comp(current->next(lvl)->data, node->data))
+            {
+                current = current->next(lvl);
+            }
+        }
+        for (current = current->next(1); current != tail && !_comp(node->data, current->data); current = current->next(1))
+        {
+            if (current == node) return true;
+        }
+        return false;
+    }
+    // Owning list of an iterator as far as the current build can tell
+    const SkipNode<T>* pos_owner([[maybe_unused]] const_iterator it) const noexcept
+    {
+#if SKIPLIST_DEBUG_CHECKS
+        return it.owner;
+#else
+        return tail;
+#endif
+    }
+};
+
+// Skip list with span widths on every link, adding positional access
+// (nth, rank, count_range, distance) at the cost of one size_t per link
+template<typename T, typename Compare = std::less<>, typename Allocator = std::allocator<T>,
+         int MaxLevel = skiplist_default_max_level>
+using IndexableSkipList = SkipList<T, Compare, Allocator, true, MaxLevel>;
 
 #endif
@@ -0,0 +1,151 @@
+/*
+ * SkipListArena.h - Slab/arena allocator tuned for SkipList towers
+ *
+ * Features:
+ * - Size classes in 16-byte steps, one per tower footprint (so one per tower height)
+ * - Per-class free lists: erased towers are recycled by later inserts
+ * - Memory is carved from large chunks and released in bulk when the last
+ *   allocator copy sharing the arena goes away
+ * - Plugs in through the Allocator template parameter:
+ *       SkipList<int, std::less<>, SkipListArenaAllocator<int>>
+ *
+ * Like SkipList itself the arena is not thread-safe.
+ *
+ * Author: Ilya Pavlov (st129535@student.spbu.ru)
+ */
+#ifndef SKIPLIST_ARENA_H
+#define SKIPLIST_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+class SkipListArena
+{
+public:
+    static constexpr std::size_t GRANULE = alignof(std::max_align_t);  // size class step
+    static constexpr std::size_t CLASS_COUNT = 64;                     // largest pooled block is 64 granules
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;               // bytes requested from the system at once
+
+    SkipListArena() = default;
+    SkipListArena(const SkipListArena&) = delete;
+    SkipListArena& operator=(const SkipListArena&) = delete;
+    // Bulk release: every chunk goes back at once, no per-block bookkeeping
+    ~SkipListArena() noexcept
+    {
+        for (void* chunk : chunks)
+        {
+            ::operator delete(chunk);
+        }
+    }
+
+    // Returns a block of at least bytes bytes, reusing a freed block of the same class if any
+    void* allocate(std::size_t bytes)
+    {
+        std::size_t cls = size_class(bytes);
+        if (cls >= CLASS_COUNT)
+        {
+            return ::operator new(bytes);
+        }
+        if (FreeBlock* block = free_lists[cls])
+        {
+            free_lists[cls] = block->next;
+            return block;
+        }
+        std::size_t block_size = (cls + 1) * GRANULE;
+        if (static_cast<std::size_t>(chunk_end - chunk_pos) < block_size)
+        {
+            refill();
+        }
+        void* block = chunk_pos;
+        chunk_pos += block_size;
+        return block;
+    }
+    // Pushes the block onto the free list of its class
+    void deallocate(void* ptr, std::size_t bytes) noexcept
+    {
+        std::size_t cls = size_class(bytes);
+        if (cls >= CLASS_COUNT)
+        {
+            ::operator delete(ptr);
+            return;
+        }
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        block->next = free_lists[cls];
+        free_lists[cls] = block;
+    }
+    // Bytes obtained from the system so far (pooled chunks only)
+    std::size_t reserved() const noexcept { return chunks.size() * CHUNK_SIZE; }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    std::vector<void*> chunks;
+    FreeBlock* free_lists[CLASS_COUNT] = {};
+    std::byte* chunk_pos = nullptr;
+    std::byte* chunk_end = nullptr;
+
+    static constexpr std::size_t size_class(std::size_t bytes) noexcept
+    {
+        return bytes == 0 ? 0 : (bytes - 1) / GRANULE;
+    }
+    // Starts a new chunk; the tail of the previous one is abandoned
+    void refill()
+    {
+        if (chunks.size() == chunks.capacity()) chunks.reserve(2 * chunks.size() + 1);
+        std::byte* chunk = static_cast<std::byte*>(::operator new(CHUNK_SIZE));
+        chunks.push_back(chunk);
+        chunk_pos = chunk;
+        chunk_end = chunk + CHUNK_SIZE;
+    }
+};
+
+template<typename T>
+class SkipListArenaAllocator
+{
+public:
+    using value_type = T;
+    // Copies share the arena, so swapping or moving containers keeps their nodes valid
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+    // Memory is returned when the arena dies: containers holding the last copies (see
+    // use_count) may skip per-node deallocate
+    using bulk_release = std::true_type;
+
+    SkipListArenaAllocator() : arena(std::make_shared<SkipListArena>()) {}
+    template<typename U>
+    SkipListArenaAllocator(const SkipListArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    T* allocate(std::size_t n)
+    {
+        static_assert(alignof(T) <= SkipListArena::GRANULE, "over-aligned types are not supported by the arena");
+        return static_cast<T*>(arena->allocate(n * sizeof(T)));
+    }
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        arena->deallocate(ptr, n * sizeof(T));
+    }
+    // A copied container gets an arena of its own
+    SkipListArenaAllocator select_on_container_copy_construction() const
+    {
+        return SkipListArenaAllocator();
+    }
+    const SkipListArena& resource() const noexcept { return *arena; }
+    // Number of allocator copies sharing the arena
+    long use_count() const noexcept { return arena.use_count(); }
+
+    template<typename U>
+    bool operator==(const SkipListArenaAllocator<U>& other) const noexcept { return arena == other.arena; }
+
+private:
+    template<typename U> friend class SkipListArenaAllocator;
+    std::shared_ptr<SkipListArena> arena;
+};
+
+#endif
@@ -0,0 +1,254 @@
+/*
+ * SkipListMmap.h - Persistent SkipList storage in a memory-mapped file (POSIX)
+ *
+ * Features:
+ * - SkipListMmapFile: a file mapped MAP_SHARED, at the address recorded in its header
+ *   when that range is free, so the raw tower pointers written by one process are
+ *   valid in the next one; otherwise it is mapped elsewhere and the list adopting the
+ *   towers rebases their links once, in O(n)
+ * - Size classes in 16-byte steps with per-class free lists kept inside the file,
+ *   like SkipListArena
+ * - MmapAllocator<T> plugs in through the Allocator template parameter:
+ *       auto file = SkipListMmapFile::open("index.skl");
+ *       SkipList<int, std::less<>, MmapAllocator<int>> sl{std::less<>(), MmapAllocator<int>(file)};
+ *   The first list built on the file is saved in it; when it is destroyed its size and
+ *   height are written back, and a list built on the reopened file adopts it in O(1)
+ * - A file left open by a process that died is recovered: the adopting list rebuilds
+ *   its upper levels from the bottom one, in O(n)
+ *
+ * Requirements and limits:
+ * - Elements must be trivially copyable (no pointers into the heap)
+ * - The file has a fixed capacity (sparse on disk until touched); allocations past it
+ *   throw std::bad_alloc
+ * - The file is locked (flock) while open; opening it again, from this process or
+ *   another one, throws std::runtime_error
+ * - Towers being reallocated by bulk operations (load, rebalance) at the time of a
+ *   crash may be lost; recovery keeps what the bottom level still links
+ * - Like SkipList itself the file is not thread-safe
+ *
+ * Author: Ilya Pavlov (st129535@student.spbu.ru)
+ */
+#ifndef SKIPLIST_MMAP_H
+#define SKIPLIST_MMAP_H
+
+#include "SkipList.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class SkipListMmapFile
+{
+public:
+    static constexpr std::size_t GRANULE = 16;                            // size class step
+    static constexpr std::size_t CLASS_COUNT = 64;                        // largest recycled block is 64 granules
+    static constexpr std::size_t DEFAULT_CAPACITY = std::size_t{1} << 30; // bytes of address space per file
+    static constexpr std::uint64_t MAGIC = 0x50414d4c50494b53ULL;          // "SKIPLMAP"
+    static constexpr std::uint32_t FORMAT = 2;
+
+    // Opens path, creating it with the given capacity if it does not exist or is empty
+    static std::shared_ptr<SkipListMmapFile> open(const std::string& path, std::size_t capacity = DEFAULT_CAPACITY)
+    {
+        return std::shared_ptr<SkipListMmapFile>(new SkipListMmapFile(path, capacity));
+    }
+    SkipListMmapFile(const SkipListMmapFile&) = delete;
+    SkipListMmapFile& operator=(const SkipListMmapFile&) = delete;
+    // Marks the file clean unless a list still has it open, then unmaps it
+    ~SkipListMmapFile() noexcept
+    {
+        if (!header->root.attached) header->clean = 1;
+        ::msync(header, header->capacity, MS_SYNC);
+        ::munmap(header, header->capacity);
+        ::close(fd);
+    }
+
+    // Returns a block of at least bytes bytes, reusing a freed block of the same class if any
+    void* allocate(std::size_t bytes)
+    {
+        std::size_t cls = size_class(bytes);
+        if (cls < CLASS_COUNT && header->free_lists[cls])
+        {
+            std::uint64_t offset = header->free_lists[cls];
+            std::memcpy(&header->free_lists[cls], at(offset), sizeof(std::uint64_t));
+            return at(offset);
+        }
+        std::size_t block_size = cls < CLASS_COUNT ? (cls + 1) * GRANULE : bytes;
+        if (block_size > header->capacity - header->used)
+        {
+            throw std::bad_alloc();
+        }
+        void* block = at(header->used);
+        header->used += (block_size + GRANULE - 1) / GRANULE * GRANULE;
+        return block;
+    }
+    // Pushes the block onto the free list of its class; larger blocks are not recycled
+    void deallocate(void* ptr, std::size_t bytes) noexcept
+    {
+        std::size_t cls = size_class(bytes);
+        if (cls >= CLASS_COUNT) return;
+        std::memcpy(ptr, &header->free_lists[cls], sizeof(std::uint64_t));
+        header->free_lists[cls] = static_cast<std::byte*>(ptr) - base();
+    }
+    // Writes dirty pages back to the file
+    void sync() const { ::msync(header, header->capacity, MS_SYNC); }
+
+    SkipListRoot* root() const noexcept { return &header->root; }
+    // Address the file is mapped at
+    const void* address() const noexcept { return header; }
+    std::size_t capacity() const noexcept { return header->capacity; }
+    // Bytes handed out so far, header included
+    std::size_t used() const noexcept { return header->used; }
+
+private:
+    // First page of the file
+    struct Header
+    {
+        std::uint64_t magic;
+        std::uint32_t format;
+        std::uint32_t clean;                      // 1 once closed with no list open
+        std::uint64_t base;                       // address the file was last mapped at
+        std::uint64_t capacity;                   // file size
+        std::uint64_t used;                       // offset of the unallocated rest
+        std::uint64_t free_lists[CLASS_COUNT];    // offsets of the first free block per class, 0 if none
+        SkipListRoot root;
+    };
+    static constexpr std::size_t HEADER_SIZE = 4096;
+    static_assert(sizeof(Header) <= HEADER_SIZE);
+
+    Header* header = nullptr;
+    int fd = -1;
+
+    SkipListMmapFile(const std::string& path, std::size_t capacity)
+    {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) fail("cannot open " + path);
+        // Released by close, also when the process dies
+        if (::flock(fd, LOCK_EX | LOCK_NB) != 0) fail(path + " is open elsewhere");
+        struct stat info;
+        if (::fstat(fd, &info) != 0) fail("cannot stat " + path);
+        if (info.st_size == 0)
+        {
+            create(capacity);
+        }else
+        {
+            reopen(static_cast<std::size_t>(info.st_size));
+        }
+        header->clean = 0;
+    }
+    void create(std::size_t capacity)
+    {
+        capacity = std::max(capacity, 2 * HEADER_SIZE);
+        if (::ftruncate(fd, static_cast<off_t>(capacity)) != 0) fail("cannot size the file");
+        map(nullptr, capacity);
+        Header fresh{};
+        fresh.magic = MAGIC;
+        fresh.format = FORMAT;
+        fresh.base = reinterpret_cast<std::uint64_t>(header);
+        fresh.capacity = capacity;
+        fresh.used = HEADER_SIZE;
+        std::memcpy(static_cast<void*>(header), &fresh, sizeof(Header));
+        sync();
+    }
+    void reopen(std::size_t file_size)
+    {
+        Header saved;
+        if (file_size < HEADER_SIZE || ::pread(fd, &saved, sizeof(Header), 0) != static_cast<ssize_t>(sizeof(Header)) ||
+            saved.magic != MAGIC || saved.format != FORMAT || saved.capacity != file_size)
+        {
+            fail("not a SkipList mmap file");
+        }
+        // The saved address if it is free (a hint where MAP_FIXED_NOREPLACE is unknown),
+        // anywhere otherwise; the saved links are then off by the distance moved
+        if (!map(reinterpret_cast<void*>(saved.base), saved.capacity, fixed_noreplace)) map(nullptr, saved.capacity);
+        std::uint64_t moved = reinterpret_cast<std::uint64_t>(header) - saved.base;
+        if (moved && header->root.head)
+        {
+            header->root.relocation += static_cast<std::int64_t>(moved);
+        }
+        header->base = reinterpret_cast<std::uint64_t>(header);
+        if (!saved.clean)
+        {
+            // The lock is ours, so the process that had the file open is gone
+            header->root.recover = header->root.head != nullptr;
+            header->root.attached = false;
+        }
+    }
+#ifdef MAP_FIXED_NOREPLACE
+    static constexpr int fixed_noreplace = MAP_FIXED_NOREPLACE;
+#else
+    static constexpr int fixed_noreplace = 0;
+#endif
+    // Maps the whole file; only a MAP_FIXED_NOREPLACE clash (EEXIST) returns false
+    bool map(void* address, std::size_t capacity, int flags = 0)
+    {
+        void* mapped = ::mmap(address, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | flags, fd, 0);
+        if (mapped == MAP_FAILED)
+        {
+            if (flags && errno == EEXIST) return false;
+            fail("mmap failed");
+        }
+        header = static_cast<Header*>(mapped);
+        return true;
+    }
+    [[noreturn]] void fail(const std::string& what)
+    {
+        if (fd >= 0) ::close(fd);
+        throw std::runtime_error("SkipListMmapFile: " + what);
+    }
+    std::byte* base() const noexcept { return reinterpret_cast<std::byte*>(header); }
+    void* at(std::uint64_t offset) const noexcept { return base() + offset; }
+    static constexpr std::size_t size_class(std::size_t bytes) noexcept
+    {
+        return bytes == 0 ? 0 : (bytes - 1) / GRANULE;
+    }
+};
+
+template<typename T>
+class MmapAllocator
+{
+public:
+    using value_type = T;
+    // Copies share the file, so swapping or moving containers keeps their nodes valid
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+    // Towers outlive the process; containers keep their state in root()
+    using persistent = std::true_type;
+
+    explicit MmapAllocator(std::shared_ptr<SkipListMmapFile> file) noexcept : file(std::move(file)) {}
+    template<typename U>
+    MmapAllocator(const MmapAllocator<U>& other) noexcept : file(other.file) {}
+
+    T* allocate(std::size_t n)
+    {
+        static_assert(alignof(T) <= SkipListMmapFile::GRANULE, "over-aligned types are not supported by the file");
+        return static_cast<T*>(file->allocate(n * sizeof(T)));
+    }
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        file->deallocate(ptr, n * sizeof(T));
+    }
+    SkipListRoot* root() const noexcept { return file->root(); }
+    SkipListMmapFile& resource() const noexcept { return *file; }
+
+    template<typename U>
+    bool operator==(const MmapAllocator<U>& other) const noexcept { return file == other.file; }
+
+private:
+    template<typename U> friend class MmapAllocator;
+    std::shared_ptr<SkipListMmapFile> file;
+};
+
+#endif
@@ -0,0 +1,371 @@
+/*
+ * SkipMap.h - Ordered key-value containers on top of SkipList
+ *
+ * Features:
+ * - SkipMap<Key, Value, Compare, Allocator>: unique keys, std::map interface
+ *   (operator[], at, try_emplace, insert_or_assign)
+ * - SkipMultiMap<Key, Value, Compare, Allocator>: equivalent keys kept in insertion order
+ * - Entries are std::pair<const Key, Value> stored once, in the tower of their key;
+ *   the comparator looks at the key only
+ * - Heterogeneous lookup (find, contains, count, bounds) with transparent comparators
+ *   such as the default std::less<>, without building a dummy entry
+ *
+ * Iterators, invalidation rules and complexity are those of SkipList.
+ *
+ * Author: Ilya Pavlov (st129535@student.spbu.ru)
+ */
+#ifndef SKIPMAP_H
+#define SKIPMAP_H
+
+#include "SkipList.h"
+#include <initializer_list>
+#include <tuple>
+
+// Orders map entries by key; keys and any type Compare accepts compare directly
+template<typename Key, typename Value, typename Compare, bool Multi>
+class SkipMapCompare
+{
+public:
+    using is_transparent = void;
+    // Tells SkipList to keep equivalent keys (SkipMultiMap)
+    using equivalent_keys = std::bool_constant<Multi>;
+
+    SkipMapCompare(const Compare& comp = Compare()) : _comp(comp) {}
+
+    template <typename A, typename B>
+    bool operator()(const A& lhs, const B& rhs) const
+    {
+        return _comp(keyOf(lhs), keyOf(rhs));
+    }
+    const Compare& key_comp() const noexcept { return _comp; }
+
+private:
+    [[no_unique_address]] Compare _comp;
+
+    static const Key& keyOf(const std::pair<const Key, Value>& entry) noexcept { return entry.first; }
+    template <typename K>
+    static const K& keyOf(const K& key) noexcept { return key; }
+};
+
+template<typename Key, typename Value, typename Compare = std::less<>,
+         typename Allocator = std::allocator<std::pair<const Key, Value>>, bool Multi = false>
+class SkipMap
+{
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<const Key, Value>;
+    using key_compare = Compare;
+    using value_compare = SkipMapCompare<Key, Value, Compare, Multi>;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+private:
+    using list_type = SkipList<value_type, value_compare, Allocator>;
+    // Lookups by other types than Key need a comparator that accepts them
+    static constexpr bool transparent = requires { typename Compare::is_transparent; };
+public:
+    using iterator = typename list_type::iterator;
+    using const_iterator = typename list_type::const_iterator;
+    using reverse_iterator = typename list_type::reverse_iterator;
+    using const_reverse_iterator = typename list_type::const_reverse_iterator;
+    // insert and emplace report whether the key was new, except in multimaps
+    using insert_result = std::conditional_t<Multi, iterator, std::pair<iterator, bool>>;
+
+    // Constructors
+    explicit SkipMap(const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : _list(value_compare(comp), alloc)
+    {
+    }
+    template <typename InputIt>
+    SkipMap(InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : SkipMap(comp, alloc)
+    {
+        insert(first, last);
+    }
+    SkipMap(std::initializer_list<value_type> init, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : SkipMap(init.begin(), init.end(), comp, alloc)
+    {
+    }
+    SkipMap(const SkipMap&) = default;
+    SkipMap(SkipMap&&) noexcept = default;
+    // Entries have a const key and cannot be assigned over, so the copy is built anew
+    SkipMap& operator=(const SkipMap& other)
+    {
+        if (this != &other)
+        {
+            list_type copy(other._list);
+            swap(_list, copy);
+        }
+        return *this;
+    }
+    SkipMap& operator=(SkipMap&&) noexcept = default;
+    SkipMap& operator=(std::initializer_list<value_type> init)
+    {
+        clear();
+        insert(init);
+        return *this;
+    }
+
+    // Iterator access methods
+    iterator begin() noexcept { return _list.begin(); }
+    iterator end() noexcept { return _list.end(); }
+    const_iterator begin() const noexcept { return _list.begin(); }
+    const_iterator end() const noexcept { return _list.end(); }
+    const_iterator cbegin() const noexcept { return _list.cbegin(); }
+    const_iterator cend() const noexcept { return _list.cend(); }
+    reverse_iterator rbegin() noexcept { return _list.rbegin(); }
+    reverse_iterator rend() noexcept { return _list.rend(); }
+    const_reverse_iterator rbegin() const noexcept { return _list.rbegin(); }
+    const_reverse_iterator rend() const noexcept { return _list.rend(); }
+    const_reverse_iterator crbegin() const noexcept { return _list.crbegin(); }
+    const_reverse_iterator crend() const noexcept { return _list.crend(); }
+
+    bool empty() const noexcept { return _list.empty(); }
+    size_type size() const noexcept { return _list.size(); }
+    void clear() { _list.clear(); }
+
+    // Element access (maps only)
+    // Value of key, value-initialized first if key is missing
+    Value& operator[](const Key& key) requires (!Multi)
+    {
+        return try_emplace(key).first->second;
+    }
+    Value& operator[](Key&& key) requires (!Multi)
+    {
+        return try_emplace(std::move(key)).first->second;
+    }
+    Value& at(const Key& key) requires (!Multi)
+    {
+        iterator it = find(key);
+        if (it == end()) throw std::out_of_range("SkipMap::at: key not found");
+        return it->second;
+    }
+    const Value& at(const Key& key) const requires (!Multi)
+    {
+        const_iterator it = find(key);
+        if (it == end()) throw std::out_of_range("SkipMap::at: key not found");
+        return it->second;
+    }
+
+    // Insert entries; multimaps place them behind their equivalents
+    insert_result insert(const value_type& value) { return result(_list.insert(value)); }
+    insert_result insert(value_type&& value) { return result(_list.insert(std::move(value))); }
+    template <typename P>
+        requires std::is_constructible_v<value_type, P&&>
+    insert_result insert(P&& value)
+    {
+        return emplace(std::forward<P>(value));
+    }
+    iterator insert(const_iterator hint, const value_type& value) { return _list.insert(hint, value); }
+    iterator insert(const_iterator hint, value_type&& value) { return _list.insert(hint, std::move(value)); }
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        _list.insert(first, last);
+    }
+    void insert(std::initializer_list<value_type> init) { insert(init.begin(), init.end()); }
+    // Construct an entry in place; a map frees it again if the key is already present
+    template <typename... Args>
+    insert_result emplace(Args&&... args)
+    {
+        size_type before = size();
+        iterator it = _list.emplace(std::forward<Args>(args)...);
+        if constexpr (Multi) return it;
+        else return {it, size() != before};
+    }
+    // Construct the value from args only if key is missing (maps only)
+    /*
+     * One descent finds the position; the entry is then built in place from key and
+     * args, so nothing is constructed, copied or moved when key is already there.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) requires (!Multi)
+    {
+        return _list.try_emplace(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                 std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) requires (!Multi)
+    {
+        return _list.try_emplace(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                 std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+    // Assign obj to the value of key, inserting the entry if key is missing (maps only)
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) requires (!Multi)
+    {
+        auto result = try_emplace(key, std::forward<M>(obj));
+        if (!result.second) result.first->second = std::forward<M>(obj);
+        return result;
+    }
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj) requires (!Multi)
+    {
+        auto result = try_emplace(std::move(key), std::forward<M>(obj));
+        if (!result.second) result.first->second = std::forward<M>(obj);
+        return result;
+    }
+
+    // Erase entries; erasing a key removes all its entries and returns their number
+    iterator erase(iterator pos) { return _list.erase(pos); }
+    iterator erase(const_iterator pos) { return _list.erase(pos); }
+    iterator erase(const_iterator first, const_iterator last) { return _list.erase(first, last); }
+    size_type erase(const Key& key) { return eraseKey(key); }
+    template <typename K>
+        requires transparent
+    size_type erase(const K& key)
+    {
+        return eraseKey(key);
+    }
+
+    // Lookups; with a transparent Compare any key type it accepts can be used
+    iterator find(const Key& key) { return findKey(*this, key); }
+    const_iterator find(const Key& key) const { return findKey(*this, key); }
+    template <typename K>
+        requires transparent
+    iterator find(const K& key)
+    {
+        return findKey(*this, key);
+    }
+    template <typename K>
+        requires transparent
+    const_iterator find(const K& key) const
+    {
+        return findKey(*this, key);
+    }
+    bool contains(const Key& key) const { return _list.contains(key); }
+    template <typename K>
+        requires transparent
+    bool contains(const K& key) const
+    {
+        return _list.contains(key);
+    }
+    size_type count(const Key& key) const { return countKey(key); }
+    template <typename K>
+        requires transparent
+    size_type count(const K& key) const
+    {
+        return countKey(key);
+    }
+    iterator lower_bound(const Key& key) { return _list.lower_bound(key); }
+    const_iterator lower_bound(const Key& key) const { return _list.lower_bound(key); }
+    template <typename K>
+        requires transparent
+    iterator lower_bound(const K& key)
+    {
+        return _list.lower_bound(key);
+    }
+    template <typename K>
+        requires transparent
+    const_iterator lower_bound(const K& key) const
+    {
+        return _list.lower_bound(key);
+    }
+    iterator upper_bound(const Key& key) { return _list.upper_bound(key); }
+    const_iterator upper_bound(const Key& key) const { return _list.upper_bound(key); }
+    template <typename K>
+        requires transparent
+    iterator upper_bound(const K& key)
+    {
+        return _list.upper_bound(key);
+    }
+    template <typename K>
+        requires transparent
+    const_iterator upper_bound(const K& key) const
+    {
+        return _list.upper_bound(key);
+    }
+    // One search, then a walk over the equivalents (see SkipList::equal_range)
+    std::pair<iterator, iterator> equal_range(const Key& key) { return asPair(_list.equal_range(key)); }
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const { return asPair(_list.equal_range(key)); }
+    template <typename K>
+        requires transparent
+    std::pair<iterator, iterator> equal_range(const K& key)
+    {
+        return asPair(_list.equal_range(key));
+    }
+    template <typename K>
+        requires transparent
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+    {
+        return asPair(_list.equal_range(key));
+    }
+    // Lazy view of the entries with keys in [lo, hi) (see SkipList::range)
+    auto range(const Key& lo, const Key& hi) { return _list.range(lo, hi); }
+    auto range(const Key& lo, const Key& hi) const { return _list.range(lo, hi); }
+
+    // Moves the entries of other whose keys are missing here (all of them for multimaps)
+    // by relinking their towers, see SkipList::merge
+    void merge(SkipMap& other) { _list.merge(other._list); }
+    void merge(SkipMap&& other) { _list.merge(std::move(other._list)); }
+
+    key_compare key_comp() const { return _list.key_comp().key_comp(); }
+    value_compare value_comp() const { return _list.key_comp(); }
+    allocator_type get_allocator() const { return _list.get_allocator(); }
+    // Level generator of the underlying list (can be reseeded for reproducible runs)
+    SkipLevelGenerator& level_generator() noexcept { return _list.level_generator(); }
+    // Check if the underlying list is correct
+    bool validate() const { return _list.validate(); }
+
+    friend void swap(SkipMap& a, SkipMap& b) noexcept(std::is_nothrow_swappable_v<list_type>)
+    {
+        swap(a._list, b._list);
+    }
+    friend bool operator==(const SkipMap& lhs, const SkipMap& rhs) { return lhs._list == rhs._list; }
+    friend bool operator!=(const SkipMap& lhs, const SkipMap& rhs) { return !(lhs == rhs); }
+
+private:
+    list_type _list;
+
+    insert_result result(std::pair<iterator, bool> inserted)
+    {
+        if constexpr (Multi) return inserted.first;
+        else return inserted;
+    }
+    template <typename Iter>
+    static std::pair<Iter, Iter> asPair(std::ranges::subrange<Iter> range) { return {range.begin(), range.end()}; }
+    template <typename Self, typename K>
+    static auto findKey(Self& self, const K& key)
+    {
+        if constexpr (Multi)
+        {
+            // The first of the equivalents, as equal_range would start
+            auto it = self._list.lower_bound(key);
+            return (it != self._list.end() && !self._list.key_comp()(key, *it)) ? it : self._list.end();
+        }else
+        {
+            return self._list.find(key);
+        }
+    }
+    template <typename K>
+    size_type countKey(const K& key) const
+    {
+        if constexpr (Multi) return std::ranges::distance(_list.equal_range(key));
+        else return contains(key) ? 1 : 0;
+    }
+    template <typename K>
+    size_type eraseKey(const K& key)
+    {
+        if constexpr (Multi)
+        {
+            const_iterator first = std::as_const(*this).lower_bound(key);
+            const_iterator last = std::as_const(*this).upper_bound(key);
+            size_type erased = std::distance(first, last);
+            _list.erase(first, last);
+            return erased;
+        }else
+        {
+            return _list.erase(key) ? 1 : 0;
+        }
+    }
+};
+
+// Ordered multimap: entries with equivalent keys are kept in insertion order
+template<typename Key, typename Value, typename Compare = std::less<>,
+         typename Allocator = std::allocator<std::pair<const Key, Value>>>
+using SkipMultiMap = SkipMap<Key, Value, Compare, Allocator, true>;
+
+#endif
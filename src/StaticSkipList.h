@@ -0,0 +1,238 @@
+/*
+ * StaticSkipList.h - Fixed-capacity SkipList whose towers live inside the object
+ *
+ * Features:
+ * - StaticSkipList<T, N, Compare> holds at most N elements and never touches the heap:
+ *   every tower, the sentinels included, takes one slot of an inline buffer
+ * - Tower heights are capped at skiplist_levels_for(N), so each slot is sized for the
+ *   tallest tower and any mix of heights fits
+ * - Same lookup and update API as SkipList (insert, emplace, erase, find, bounds,
+ *   range views, iteration); inserting into a full list throws std::bad_alloc
+ * - Copies and moves copy or move the elements into the destination's own buffer
+ *
+ * Operations that hand towers to another list (split, join, merge, swap) are not
+ * offered, since the towers cannot leave the buffer they were carved from.
+ * Like SkipList itself the list is not thread-safe.
+ *
+ * Author: Ilya Pavlov (st129535@student.spbu.ru)
+ */
+#ifndef STATIC_SKIPLIST_H
+#define STATIC_SKIPLIST_H
+
+#include "SkipList.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Inline pool of equal slots with an intrusive free list
+template<std::size_t SlotBytes, std::size_t SlotAlign, std::size_t Slots>
+class StaticSkipListPool
+{
+    static_assert(SlotBytes % SlotAlign == 0 && SlotBytes >= sizeof(void*), "slots must be aligned and hold a link");
+
+public:
+    StaticSkipListPool() = default;
+    StaticSkipListPool(const StaticSkipListPool&) = delete;
+    StaticSkipListPool& operator=(const StaticSkipListPool&) = delete;
+
+    // Returns a free slot, or throws std::bad_alloc if none is left or bytes do not fit one
+    void* allocate(std::size_t bytes)
+    {
+        if (bytes > SlotBytes) throw std::bad_alloc();
+        if (FreeSlot* slot = free_list)
+        {
+            free_list = slot->next;
+            return slot;
+        }
+        if (bumped == Slots) throw std::bad_alloc();
+        return storage + SlotBytes * bumped++;
+    }
+    // Pushes the slot onto the free list
+    void deallocate(void* ptr) noexcept
+    {
+        FreeSlot* slot = ::new (ptr) FreeSlot{free_list};
+        free_list = slot;
+    }
+
+private:
+    struct FreeSlot
+    {
+        FreeSlot* next;
+    };
+
+    alignas(SlotAlign) std::byte storage[SlotBytes * Slots];
+    FreeSlot* free_list = nullptr;
+    std::size_t bumped = 0;     // slots handed out from storage so far
+};
+
+// Allocator over a StaticSkipListPool; copies share the pool of the list they came from
+template<typename T, typename Pool>
+class StaticSkipListAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    explicit StaticSkipListAllocator(Pool& pool) noexcept : pool(&pool) {}
+    template<typename U>
+    StaticSkipListAllocator(const StaticSkipListAllocator<U, Pool>& other) noexcept : pool(other.pool) {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(pool->allocate(n * sizeof(T))); }
+    void deallocate(T* ptr, std::size_t) noexcept { pool->deallocate(ptr); }
+
+    template<typename U>
+    bool operator==(const StaticSkipListAllocator<U, Pool>& other) const noexcept { return pool == other.pool; }
+
+private:
+    template<typename, typename> friend class StaticSkipListAllocator;
+    Pool* pool;
+};
+
+namespace static_skiplist_detail
+{
+    // Slot large enough for a tower of the given height (see SkipList::node_units)
+    template<typename T, int Height>
+    inline constexpr std::size_t slot_bytes =
+        (sizeof(SkipNode<T>) + Height * sizeof(SkipNode<T>*) + sizeof(SkipNodeWord<T>) - 1) / sizeof(SkipNodeWord<T>) * sizeof(SkipNodeWord<T>);
+
+    template<typename T, std::size_t N>
+    using pool = StaticSkipListPool<std::max(slot_bytes<T, skiplist_levels_for(N)>, sizeof(void*)),
+                                    std::max(alignof(SkipNodeWord<T>), alignof(void*)), N + 2>;
+
+    // Base-from-member: the pool is built before (and destroyed after) the list using it
+    template<typename T, std::size_t N>
+    struct storage
+    {
+        pool<T, N> _pool;
+    };
+}
+
+template<typename T, std::size_t N, typename Compare = std::less<>>
+class StaticSkipList
+    : private static_skiplist_detail::storage<T, N>,
+      private SkipList<T, Compare, StaticSkipListAllocator<T, static_skiplist_detail::pool<T, N>>, false, skiplist_levels_for(N)>
+{
+    static_assert(N > 0, "StaticSkipList needs room for at least one element");
+    using pool_type = static_skiplist_detail::pool<T, N>;
+    using base = SkipList<T, Compare, StaticSkipListAllocator<T, pool_type>, false, skiplist_levels_for(N)>;
+
+public:
+    using typename base::value_type;
+    using typename base::reference;
+    using typename base::const_reference;
+    using typename base::size_type;
+    using typename base::difference_type;
+    using typename base::allocator_type;
+    using typename base::iterator;
+    using typename base::const_iterator;
+    using typename base::reverse_iterator;
+    using typename base::const_reverse_iterator;
+
+    explicit StaticSkipList(const Compare& comp = Compare()) : base(comp, allocator_type(this->_pool)) {}
+    // Build from a sorted range of unique keys in linear time (see assign_sorted)
+    template <typename InputIt>
+    StaticSkipList(sorted_unique_t, InputIt first, InputIt last, const Compare& comp = Compare())
+        : StaticSkipList(comp)
+    {
+        base::assign_sorted(first, last);
+    }
+    StaticSkipList(const StaticSkipList& other) : StaticSkipList(other.key_comp())
+    {
+        base::assign_sorted(other.begin(), other.end());
+    }
+    // Elements are moved into this buffer; other is left empty
+    StaticSkipList(StaticSkipList&& other) : StaticSkipList(other.key_comp())
+    {
+        base::assign_sorted(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        other.clear();
+    }
+    StaticSkipList& operator=(const StaticSkipList& other)
+    {
+        if (this != &other) base::assign_sorted(other.begin(), other.end());
+        return *this;
+    }
+    StaticSkipList& operator=(StaticSkipList&& other)
+    {
+        if (this != &other)
+        {
+            base::assign_sorted(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            other.clear();
+        }
+        return *this;
+    }
+    ~StaticSkipList() = default;
+
+    // Iterator access methods
+    using base::begin;
+    using base::end;
+    using base::cbegin;
+    using base::cend;
+    using base::rbegin;
+    using base::rend;
+    using base::crbegin;
+    using base::crend;
+
+    // Capacity
+    using base::empty;
+    using base::size;
+    static constexpr size_type capacity() noexcept { return N; }
+    static constexpr size_type max_size() noexcept { return N; }
+    bool full() const noexcept { return size() == N; }
+    using base::max_level;
+
+    // Modifiers
+    using base::insert;
+    // Construct in-place; a full list still accepts keys that are already present
+    /*
+     * SkipList::emplace builds the tower before looking for the key, which a full
+     * buffer cannot do. Once full, the value is built on the stack instead and
+     * handed to insert, which searches first and only then allocates.
+     */
+    template <typename... Args>
+    iterator emplace(Args&&... args)
+    {
+        if (!full()) return base::emplace(std::forward<Args>(args)...);
+        T value(std::forward<Args>(args)...);
+        return base::insert(std::move(value)).first;
+    }
+    using base::try_emplace;
+    using base::assign_sorted;
+    using base::erase;
+    using base::clear;
+
+    // Lookup
+    using base::find;
+    using base::contains;
+    using base::lower_bound;
+    using base::upper_bound;
+    using base::range;
+    using base::equal_range;
+    using base::find_from;
+    using base::lower_bound_from;
+    using base::find_batch;
+    using base::contains_batch;
+
+    // Utility
+    using base::key_comp;
+    using base::level_generator;
+    using base::use_finger;
+    using base::uses_finger;
+    using base::validate;
+    using base::stats;
+    using base::search_path;
+    using base::reset_stats;
+
+    friend bool operator==(const StaticSkipList& lsl, const StaticSkipList& rsl)
+    {
+        return static_cast<const base&>(lsl) == static_cast<const base&>(rsl);
+    }
+    friend bool operator!=(const StaticSkipList& lsl, const StaticSkipList& rsl) { return !(lsl == rsl); }
+};
+
+#endif
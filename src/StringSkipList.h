@@ -0,0 +1,688 @@
+/*
+ * StringSkipList.h - Skip list of byte strings with inline prefixes and out-of-line key storage
+ *
+ * Features:
+ * - Ordered set of strings (the order of std::string) with insert, erase, find, contains,
+ *   lower_bound, upper_bound and forward iteration over std::string_view
+ * - Key bytes are stored once, packed into arena chunks owned by the list; every link
+ *   keeps a window of PREFIX_BYTES bytes of the key it leads to, so comparisons that
+ *   end inside it touch neither the arena nor the next tower
+ * - The window holds the first bytes of the key, or with PrefixCompression the bytes
+ *   that follow the prefix shared with the predecessor on that level, which is where
+ *   a search resumes comparing (for keys that all start alike, such as URLs)
+ * - Every link records the length of the prefix its two towers share, so a search that
+ *   knows how much of the key matches its predecessor skips those bytes, and passes
+ *   towers that agree with the predecessor past that point without comparing at all
+ *   (mostly-shared prefixes such as URLs cost one byte comparison per new byte)
+ * - Erased keys leave holes in the arena; it is compacted once they outweigh live keys
+ *
+ * Iterators stay valid until their element is erased, but the string_views they return
+ * may move on any erase (compaction). Like SkipList it is not thread-safe.
+ *
+ * Author: Ilya Pavlov (st129535@student.spbu.ru)
+ *
+ * StringSkipList Invariants:
+ * 1. Keys are sorted and unique on every level, each level a subset of the one below
+ * 2. link(l).lcp of a tower is the length of the common prefix of its key and the key
+ *    of link(l).next (0 from head)
+ * 3. link(l).window holds the bytes of the next key from offset 0, or from link(l).lcp
+ *    with PrefixCompression (at most PREFIX_BYTES, zero padded)
+ * 4. current_max_level is the highest non-empty level (at least 1)
+ */
+#ifndef STRING_SKIPLIST_H
+#define STRING_SKIPLIST_H
+
+#include "SkipList.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Counters of StringSkipList::stats(), collected with -DSKIPLIST_STATS
+struct StringSkipListStats
+{
+    std::size_t comparisons = 0;    // keys compared byte by byte during searches
+    std::size_t payload_reads = 0;  // of those, comparisons that read past the inline window
+
+    double payload_read_ratio() const noexcept { return comparisons ? double(payload_reads) / comparisons : 0.0; }
+};
+
+template<typename Allocator = std::allocator<char>, bool PrefixCompression = false>
+class StringSkipList
+{
+public:
+    static constexpr int MAX_LVL = skiplist_default_max_level;
+    static constexpr std::size_t PREFIX_BYTES = 8;       // key bytes kept in every link
+    static constexpr bool prefix_compression = PrefixCompression;
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024; // arena bytes requested at once
+    static constexpr std::size_t MAX_KEY_BYTES = UINT32_MAX; // longer keys throw std::length_error
+
+private:
+    struct Node;
+    // Forward link of one level, with the common prefix length of both keys and the
+    // window of the next key
+    struct Link
+    {
+        Node* next;
+        std::uint32_t lcp;
+        std::uint8_t rest;                  // next key bytes from the window on, capped at 255
+        unsigned char window[PREFIX_BYTES];
+    };
+    struct alignas(Link) Node
+    {
+        const char* bytes;                      // key in the arena (nullptr if empty)
+        std::size_t size;                       // key length
+        int height;                             // number of levels the tower is linked into
+
+        // Links are stored inline after the node (one per level)
+        Link& link(int level) noexcept { return reinterpret_cast<Link*>(this + 1)[level - 1]; }
+        const Link& link(int level) const noexcept { return reinterpret_cast<const Link*>(this + 1)[level - 1]; }
+        std::string_view key() const noexcept { return {bytes, size}; }
+    };
+    struct alignas(Node) NodeWord
+    {
+        unsigned char bytes[alignof(Node)];
+    };
+    // Arena chunk: keys are appended until it is full
+    struct Chunk
+    {
+        char* data;
+        std::size_t capacity;
+        std::size_t used;
+    };
+
+public:
+    // Forward iterator over std::string_view
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        const_iterator() = default;
+
+        reference operator*() const noexcept { return current->key(); }
+
+        const_iterator& operator++() noexcept
+        {
+            current = current->link(1).next;
+            return *this;
+        }
+        const_iterator operator++(int) noexcept
+        {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const noexcept { return current == other.current; }
+        bool operator!=(const const_iterator& other) const noexcept { return current != other.current; }
+
+    private:
+        friend class StringSkipList;
+        explicit const_iterator(const Node* node) noexcept : current(node) {}
+        const Node* current = nullptr;
+    };
+    using iterator = const_iterator;
+
+    //types initialization
+    using value_type = std::string_view;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type = Allocator;
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<NodeWord>;
+    using byte_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<char>;
+
+    // Constructor and destructor
+    explicit StringSkipList(const Allocator& alloc = Allocator())
+        : _alloc(alloc),
+          _node_alloc(alloc),
+          _byte_alloc(alloc)
+    {
+        head = create_node(MAX_LVL, std::string_view());
+    }
+    // Build from a sorted range of unique keys in linear time (see assign_sorted)
+    template <typename InputIt>
+    StringSkipList(sorted_unique_t, InputIt first, InputIt last, const Allocator& alloc = Allocator())
+        : StringSkipList(alloc)
+    {
+        assign_sorted(first, last);
+    }
+    // Copy constructor: towers keep their heights, keys are packed into a fresh arena
+    // (the delegated constructor has finished, so a throw destroys what was copied)
+    StringSkipList(const StringSkipList& other)
+        : StringSkipList(std::allocator_traits<Allocator>::select_on_container_copy_construction(other._alloc))
+    {
+        _level_gen = other._level_gen;
+        append_state last;
+        for (const Node* node = other.head->link(1).next, *prev = other.head; node; prev = node, node = node->link(1).next)
+        {
+            appendTower(create_node(node->height, node->key()), last, prev->link(1).lcp);
+        }
+    }
+    StringSkipList(StringSkipList&& other) noexcept
+        : _alloc(other._alloc),
+          _node_alloc(other._node_alloc),
+          _byte_alloc(other._byte_alloc),
+          head(std::exchange(other.head, nullptr)),
+          current_max_level(std::exchange(other.current_max_level, 1)),
+          _size(std::exchange(other._size, 0)),
+          _live_bytes(std::exchange(other._live_bytes, 0)),
+          _dead_bytes(std::exchange(other._dead_bytes, 0)),
+          _chunks(std::move(other._chunks)),
+          _level_gen(other._level_gen)
+    {
+        other._chunks.clear();
+        other.head = other.create_node(MAX_LVL, std::string_view());
+    }
+    StringSkipList& operator=(StringSkipList other) noexcept
+    {
+        swap(*this, other);
+        return *this;
+    }
+    ~StringSkipList() noexcept
+    {
+        if (head) destroyAll();
+    }
+
+    friend void swap(StringSkipList& a, StringSkipList& b) noexcept
+    {
+        using std::swap;
+        swap(a._alloc, b._alloc);
+        swap(a._node_alloc, b._node_alloc);
+        swap(a._byte_alloc, b._byte_alloc);
+        swap(a.head, b.head);
+        swap(a.current_max_level, b.current_max_level);
+        swap(a._size, b._size);
+        swap(a._live_bytes, b._live_bytes);
+        swap(a._dead_bytes, b._dead_bytes);
+        swap(a._chunks, b._chunks);
+        swap(a._level_gen, b._level_gen);
+    }
+
+    Allocator get_allocator() const { return _alloc; }
+
+    // Iterator access methods
+    const_iterator begin() const noexcept { return const_iterator(head->link(1).next); }
+    const_iterator end() const noexcept { return const_iterator(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Capacity
+    bool empty() const noexcept { return _size == 0; }
+    size_t size() const noexcept { return _size; }
+    // Bytes of the keys currently stored
+    size_t key_bytes() const noexcept { return _live_bytes; }
+    // Bytes obtained for the arena
+    size_t arena_bytes() const noexcept
+    {
+        size_t total = 0;
+        for (const Chunk& chunk : _chunks) total += chunk.capacity;
+        return total;
+    }
+
+    // Insert element
+    /*
+     * The descent leaves, on every level, the predecessor with its common prefix
+     * with key and the common prefix of key with the successor; those are exactly
+     * the lcp values of the two links the new tower splits.
+     */
+    std::pair<iterator, bool> insert(std::string_view key)
+    {
+        if (key.size() > MAX_KEY_BYTES) throw std::length_error("StringSkipList: key too long");
+        search_path path;
+        bool equal = false;
+        Node* successor = descend(key, &path, equal);
+        if (equal) return {const_iterator(successor), false};
+        int height = _level_gen(MAX_LVL);
+        Node* node = create_node(height, key);
+        for (int l = 1; l <= height; ++l)
+        {
+            Link& pred_link = path.preds[l]->link(l);
+            setLink(node->link(l), pred_link.next, path.succ_lcp[l]);
+            setLink(pred_link, node, path.pred_lcp[l]);
+        }
+        current_max_level = std::max(current_max_level, height);
+        ++_size;
+        return {const_iterator(node), true};
+    }
+    // Range insert
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first) insert(std::string_view(*first));
+    }
+    // Replace the contents with a sorted range of unique keys in linear time
+    template <typename InputIt>
+    void assign_sorted(InputIt first, InputIt last)
+    {
+        clear();
+        append_state state;
+        std::string_view prev;
+        for (bool first_key = true; first != last; ++first, first_key = false)
+        {
+            std::string_view key(*first);
+            if (!first_key && !(prev < key))
+            {
+                throw std::invalid_argument("assign_sorted: input is not sorted and unique");
+            }
+            if (key.size() > MAX_KEY_BYTES) throw std::length_error("StringSkipList: key too long");
+            size_t lcp = first_key ? 0 : commonPrefix(prev, key);
+            Node* node = create_node(_level_gen(MAX_LVL), key);
+            appendTower(node, state, lcp);
+            prev = node->key();
+        }
+    }
+
+    // Erase by value
+    /*
+     * A predecessor taking over the successor of the erased tower shares with it
+     * the shorter of the two prefixes around the erased key.
+     */
+    bool erase(std::string_view key)
+    {
+        search_path path;
+        bool equal = false;
+        Node* node = descend(key, &path, equal);
+        if (!equal) return false;
+        for (int l = 1; l <= node->height; ++l)
+        {
+            Link& pred_link = path.preds[l]->link(l);
+            setLink(pred_link, node->link(l).next, std::min(pred_link.lcp, node->link(l).lcp));
+        }
+        _live_bytes -= node->size;
+        _dead_bytes += node->size;
+        delete_node(node);
+        --_size;
+        while (current_max_level > 1 && !head->link(current_max_level).next) --current_max_level;
+        if (_dead_bytes > _live_bytes && _dead_bytes >= CHUNK_SIZE) compact();
+        return true;
+    }
+    // Erase all elements, keeping one arena chunk
+    void clear() noexcept
+    {
+        for (Node* node = head->link(1).next; node;)
+        {
+            Node* next_node = node->link(1).next;
+            delete_node(node);
+            node = next_node;
+        }
+        for (int l = 1; l <= MAX_LVL; ++l) setLink(head->link(l), nullptr, 0);
+        while (_chunks.size() > 1)
+        {
+            releaseChunk(_chunks.back());
+            _chunks.pop_back();
+        }
+        if (!_chunks.empty()) _chunks.front().used = 0;
+        current_max_level = 1;
+        _size = 0;
+        _live_bytes = 0;
+        _dead_bytes = 0;
+    }
+
+    // Lookup
+    const_iterator find(std::string_view key) const
+    {
+        bool equal = false;
+        const Node* node = descend(key, nullptr, equal);
+        return equal ? const_iterator(node) : end();
+    }
+    bool contains(std::string_view key) const
+    {
+        bool equal = false;
+        descend(key, nullptr, equal);
+        return equal;
+    }
+    // First not less than key
+    const_iterator lower_bound(std::string_view key) const
+    {
+        bool equal = false;
+        return const_iterator(descend(key, nullptr, equal));
+    }
+    // First greater than key
+    const_iterator upper_bound(std::string_view key) const
+    {
+        bool equal = false;
+        const Node* node = descend(key, nullptr, equal);
+        return const_iterator(equal ? node->link(1).next : node);
+    }
+
+    // Search counters (zero unless built with -DSKIPLIST_STATS)
+    StringSkipListStats stats() const noexcept
+    {
+#if SKIPLIST_STATS
+        return _counters;
+#else
+        return {};
+#endif
+    }
+    void reset_stats() noexcept
+    {
+#if SKIPLIST_STATS
+        _counters = {};
+#endif
+    }
+
+    // Check if container is correct
+    bool validate() const
+    {
+        size_t count = 0, bytes = 0;
+        for (int l = 1; l <= MAX_LVL; ++l)
+        {
+            const Node* prev = head;
+            for (const Node* node = head->link(l).next; node; prev = node, node = node->link(l).next)
+            {
+                if (node->height < l) return false;
+                if (prev != head && !(prev->key() < node->key())) return false;
+                const Link& link = prev->link(l);
+                if (link.lcp != (prev == head ? 0 : commonPrefix(prev->key(), node->key()))) return false;
+                Link expected;
+                setLink(expected, const_cast<Node*>(node), link.lcp);
+                if (expected.rest != link.rest || std::memcmp(expected.window, link.window, PREFIX_BYTES) != 0) return false;
+                if (l == 1)
+                {
+                    ++count;
+                    bytes += node->size;
+                }
+            }
+            if (l > current_max_level && head->link(l).next) return false;
+        }
+        if (current_max_level > 1 && !head->link(current_max_level).next) return false;
+        return count == _size && bytes == _live_bytes;
+    }
+
+private:
+    // Per-level state of a descent (index 0 unused)
+    struct search_path
+    {
+        std::array<Node*, MAX_LVL + 1> preds;
+        std::array<size_t, MAX_LVL + 1> pred_lcp;  // common prefix of key and preds[l]
+        std::array<size_t, MAX_LVL + 1> succ_lcp;  // common prefix of key and preds[l]'s successor
+    };
+    // Rightmost towers of a build and the common prefix of each with the last key
+    struct append_state
+    {
+        std::array<Node*, MAX_LVL + 1> last{};
+        std::array<size_t, MAX_LVL + 1> lcp{};
+        bool started = false;
+    };
+
+    Allocator _alloc;
+    node_allocator _node_alloc;
+    byte_allocator _byte_alloc;
+    Node* head = nullptr;
+    int current_max_level = 1;
+    size_t _size = 0;
+    size_t _live_bytes = 0;
+    size_t _dead_bytes = 0;     // arena bytes of erased keys, reclaimed by compact()
+    std::vector<Chunk> _chunks;
+    SkipLevelGenerator _level_gen;
+#if SKIPLIST_STATS
+    mutable StringSkipListStats _counters;
+#endif
+
+    static size_t commonPrefix(std::string_view a, std::string_view b) noexcept
+    {
+        size_t limit = std::min(a.size(), b.size());
+        return static_cast<size_t>(std::mismatch(a.begin(), a.begin() + limit, b.begin()).first - a.begin());
+    }
+    // Compares key with the key link leads to, both known to agree on their first from
+    // bytes. Returns the length of their common prefix; order is negative, zero or
+    // positive as key is less than, equal to or greater than that key
+    /*
+     * The window and rest settle the comparison whenever the keys differ inside the
+     * window or one of them ends there; only then is the next tower left untouched.
+     */
+    size_t compareFrom(std::string_view key, const Link& link, size_t from, int& order) const noexcept
+    {
+#if SKIPLIST_STATS
+        ++_counters.comparisons;
+#endif
+        const size_t window_at = windowOffset(link.lcp);
+        const size_t window_end = window_at + std::min<size_t>(link.rest, PREFIX_BYTES);
+        const bool ends_inside = link.rest <= PREFIX_BYTES;   // next key is window_end bytes long
+        size_t i = from;
+        if (i >= window_at && i <= window_end)
+        {
+            const size_t stop = std::min(key.size(), window_end);
+            while (i < stop && static_cast<unsigned char>(key[i]) == link.window[i - window_at]) ++i;
+            if (i < stop)
+            {
+                order = static_cast<unsigned char>(key[i]) < link.window[i - window_at] ? -1 : 1;
+                return i;
+            }
+            if (i == key.size())
+            {
+                order = ends_inside && i == window_end ? 0 : -1;
+                return i;
+            }
+            if (ends_inside)
+            {
+                order = 1;
+                return i;
+            }
+        }
+#if SKIPLIST_STATS
+        ++_counters.payload_reads;
+#endif
+        const Node* node = link.next;
+        const size_t limit = std::min(key.size(), node->size);
+        i = static_cast<size_t>(std::mismatch(key.data() + i, key.data() + limit, node->bytes + i).first - key.data());
+        if (i < limit)
+        {
+            order = static_cast<unsigned char>(key[i]) < static_cast<unsigned char>(node->bytes[i]) ? -1 : 1;
+        }else
+        {
+            order = key.size() < node->size ? -1 : (key.size() > node->size ? 1 : 0);
+        }
+        return i;
+    }
+    // Search for the first tower not less than key
+    /*
+     * matched is the common prefix of key and the current predecessor. A link whose
+     * towers share more than that leads to a tower that differs from key where the
+     * predecessor does, so it is smaller than key; one sharing less leads to a
+     * larger tower. Only equal lengths need a comparison, starting at matched.
+     */
+    Node* descend(std::string_view key, search_path* path, bool& equal) const
+    {
+        Node* pred = head;
+        Node* curr = nullptr;
+        size_t matched = 0;
+        size_t curr_lcp = 0;
+        for (int l = current_max_level; l >= 1; --l)
+        {
+            while (true)
+            {
+                const Link& link = pred->link(l);
+                curr = link.next;
+                if (!curr)
+                {
+                    curr_lcp = 0;
+                    equal = false;
+                    break;
+                }
+                if (link.lcp > matched)
+                {
+                    pred = curr;
+                    continue;
+                }
+                if (link.lcp < matched)
+                {
+                    curr_lcp = link.lcp;
+                    equal = false;
+                    break;
+                }
+                int order;
+                size_t common = compareFrom(key, link, matched, order);
+                if (order > 0)
+                {
+                    pred = curr;
+                    matched = common;
+                    continue;
+                }
+                curr_lcp = common;
+                equal = order == 0;
+                break;
+            }
+            if (!path)
+            {
+                if (equal) return curr;
+                continue;
+            }
+            path->preds[l] = pred;
+            path->pred_lcp[l] = matched;
+            path->succ_lcp[l] = curr_lcp;
+        }
+        if (path)
+        {
+            for (int l = current_max_level + 1; l <= MAX_LVL; ++l)
+            {
+                path->preds[l] = head;
+                path->pred_lcp[l] = 0;
+                path->succ_lcp[l] = 0;
+            }
+        }
+        return curr;
+    }
+    // Links node after the rightmost towers of a sorted build; lcp is its common
+    // prefix with the previous key (a tower shares with a later one the minimum
+    // of the prefixes along the bottom level between them)
+    void appendTower(Node* node, append_state& state, size_t lcp) noexcept
+    {
+        if (!state.started)
+        {
+            state.last.fill(head);
+            state.lcp.fill(0);
+            state.started = true;
+        }
+        for (int l = 1; l <= MAX_LVL; ++l)
+        {
+            state.lcp[l] = std::min(state.lcp[l], lcp);
+        }
+        for (int l = 1; l <= node->height; ++l)
+        {
+            setLink(state.last[l]->link(l), node, state.last[l] == head ? 0 : state.lcp[l]);
+            state.last[l] = node;
+            state.lcp[l] = std::numeric_limits<size_t>::max();
+        }
+        current_max_level = std::max(current_max_level, node->height);
+        ++_size;
+    }
+
+    // Number of allocation units occupied by a tower of the given height
+    static constexpr size_t node_units(int height) noexcept
+    {
+        return (sizeof(Node) + height * sizeof(Link) + sizeof(NodeWord) - 1) / sizeof(NodeWord);
+    }
+    // Creates a tower for key, copying its bytes into the arena
+    Node* create_node(int height, std::string_view key)
+    {
+        const char* bytes = storeKey(key);
+        NodeWord* raw;
+        try
+        {
+            raw = std::allocator_traits<node_allocator>::allocate(_node_alloc, node_units(height));
+        }catch(...)
+        {
+            _live_bytes -= key.size();
+            _dead_bytes += key.size();
+            throw;
+        }
+        Node* node = ::new (static_cast<void*>(raw)) Node{bytes, key.size(), height};
+        for (int l = 1; l <= height; ++l)
+        {
+            ::new (static_cast<void*>(&node->link(l))) Link{nullptr, 0, 0, {}};
+        }
+        return node;
+    }
+    // Offset in the next key of the window of a link sharing lcp bytes
+    static constexpr size_t windowOffset(size_t lcp) noexcept { return prefix_compression ? lcp : 0; }
+    // Points link at next and copies the window of its key
+    static void setLink(Link& link, Node* next, size_t lcp) noexcept
+    {
+        link.next = next;
+        link.lcp = static_cast<std::uint32_t>(lcp);
+        std::memset(link.window, 0, PREFIX_BYTES);
+        size_t at = windowOffset(lcp);
+        size_t rest = next ? next->size - at : 0;
+        link.rest = static_cast<std::uint8_t>(std::min<size_t>(rest, 255));
+        if (rest) std::memcpy(link.window, next->bytes + at, std::min(rest, PREFIX_BYTES));
+    }
+    void delete_node(Node* node) noexcept
+    {
+        std::allocator_traits<node_allocator>::deallocate(_node_alloc, reinterpret_cast<NodeWord*>(node), node_units(node->height));
+    }
+    // Frees every tower and chunk
+    void destroyAll() noexcept
+    {
+        clear();
+        for (Chunk& chunk : _chunks) releaseChunk(chunk);
+        _chunks.clear();
+        delete_node(head);
+        head = nullptr;
+    }
+
+    // Arena
+    // Appends key to the last chunk, opening a new one when it does not fit
+    const char* storeKey(std::string_view key)
+    {
+        if (key.empty()) return nullptr;
+        if (_chunks.empty() || _chunks.back().capacity - _chunks.back().used < key.size())
+        {
+            size_t capacity = std::max(CHUNK_SIZE, key.size());
+            if (_chunks.size() == _chunks.capacity()) _chunks.reserve(2 * _chunks.size() + 1);
+            _chunks.push_back({std::allocator_traits<byte_allocator>::allocate(_byte_alloc, capacity), capacity, 0});
+        }
+        Chunk& chunk = _chunks.back();
+        char* bytes = chunk.data + chunk.used;
+        std::memcpy(bytes, key.data(), key.size());
+        chunk.used += key.size();
+        _live_bytes += key.size();
+        return bytes;
+    }
+    void releaseChunk(Chunk& chunk) noexcept
+    {
+        std::allocator_traits<byte_allocator>::deallocate(_byte_alloc, chunk.data, chunk.capacity);
+    }
+    // Copies the live keys into fresh chunks in list order and frees the old ones;
+    // keeps the old arena if allocating fails
+    void compact() noexcept
+    {
+        std::vector<Chunk> old_chunks;
+        old_chunks.swap(_chunks);
+        std::vector<std::pair<Node*, const char*>> moved;
+        const size_t live = _live_bytes;
+        try
+        {
+            moved.reserve(_size);
+            for (Node* node = head->link(1).next; node; node = node->link(1).next)
+            {
+                moved.emplace_back(node, storeKey(node->key()));
+            }
+        }catch(...)
+        {
+            for (Chunk& chunk : _chunks) releaseChunk(chunk);
+            _chunks.swap(old_chunks);
+            _live_bytes = live;
+            return;
+        }
+        _live_bytes = live;
+        for (auto& [node, bytes] : moved) node->bytes = bytes;
+        for (Chunk& chunk : old_chunks) releaseChunk(chunk);
+        _dead_bytes = 0;
+    }
+};
+
+#endif
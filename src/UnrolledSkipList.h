@@ -0,0 +1,734 @@
+/*
+ * UnrolledSkipList.h - Skip list over sorted key blocks for small trivially copyable types
+ *
+ * Features:
+ * - Every tower carries a sorted block of up to BLOCK_KEYS keys sized to BlockBytes
+ *   (two cache lines by default), so links are paid per block instead of per key
+ * - Blocks are ordered by their first key: a lookup descends over first keys and
+ *   ends with a branchless binary search inside a single block, or with a vector
+ *   count of the smaller keys for arithmetic keys under std::less (SkipListSimd.h)
+ * - Full blocks split in half; a block running low on keys absorbs a neighbour
+ * - CompactSkipList<T> picks UnrolledSkipList for small trivially copyable T and
+ *   SkipList for everything else
+ *
+ * Differences from SkipList: elements cannot be modified through iterators
+ * (iterator is const_iterator, as in std::set), and every insert or erase
+ * invalidates iterators and references because keys move inside and between blocks.
+ *
+ * Like SkipList it is not thread-safe.
+ *
+ * Author: Ilya Pavlov (st129535@student.spbu.ru)
+
+ * UnrolledSkipList Invariants:
+ * 1. Keys are sorted and unique across the bottom level, block after block
+ * 2. Every linked block holds 1..BLOCK_KEYS keys; keys[0] orders the blocks on each level
+ * 3. Higher levels are subsets of lower levels, head and tail terminate every level
+ * 4. current_max_level is the highest non-empty level (at least 1)
+ */
+#ifndef UNROLLED_SKIPLIST_H
+#define UNROLLED_SKIPLIST_H
+
+#include "SkipList.h"
+#include "SkipListSimd.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+template<typename T, typename Compare = std::less<>, typename Allocator = std::allocator<T>, std::size_t BlockBytes = 128>
+class UnrolledSkipList
+{
+    static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>,
+                  "UnrolledSkipList keeps keys in raw blocks: T must be trivially copyable");
+    static_assert(alignof(T) <= alignof(void*), "over-aligned keys are not supported");
+
+    // Bytes of a block before its keys: left link, height and count
+    static constexpr std::size_t BLOCK_HEADER = sizeof(void*) + 2 * sizeof(int);
+
+public:
+    // Keys per block: header, keys and the first link fill BlockBytes
+    static constexpr std::size_t BLOCK_KEYS =
+        std::max<std::size_t>(4, (BlockBytes - BLOCK_HEADER - sizeof(void*)) / sizeof(T));
+
+private:
+    struct Block
+    {
+        Block* left;         // previous block at the bottom level
+        int height;          // number of levels the block is linked into
+        int count;           // keys in use
+        T keys[BLOCK_KEYS];  // sorted keys, followed inline by height forward links
+
+        Block*& next(int level) noexcept { return reinterpret_cast<Block**>(this + 1)[level - 1]; }
+        Block* const& next(int level) const noexcept { return reinterpret_cast<Block* const*>(this + 1)[level - 1]; }
+    };
+
+public:
+    // Bidirectional iterator over the keys; a position is a block and an index into it
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return block->keys[index]; }
+        pointer operator->() const { return &block->keys[index]; }
+
+        const_iterator& operator++()
+        {
+            if (++index >= block->count)
+            {
+                block = block->next(1);
+                index = 0;
+            }
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+        // --end() is the last key (the tail block holds none)
+        const_iterator& operator--()
+        {
+            if (index == 0)
+            {
+                block = block->left;
+                index = block->count - 1;
+            }else
+            {
+                --index;
+            }
+            return *this;
+        }
+        const_iterator operator--(int)
+        {
+            const_iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const { return block == other.block && index == other.index; }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class UnrolledSkipList;
+        const_iterator(const Block* b, int i) : block(b), index(i) {}
+        const Block* block = nullptr;
+        int index = 0;
+    };
+    using iterator = const_iterator;
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using allocator_type = Allocator;
+    using block_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block*>;
+
+    // Constructor and destructor
+    explicit UnrolledSkipList(const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : _alloc(alloc),
+          _block_alloc(alloc),
+          _comp(comp)
+    {
+        initSentinels();
+    }
+    // Constructor with an explicit level generator (promotion probability / seed)
+    explicit UnrolledSkipList(const SkipLevelGenerator& level_gen, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : UnrolledSkipList(comp, alloc)
+    {
+        _level_gen = level_gen;
+    }
+    // Copy constructor: blocks are cloned as they are in one sweep
+    UnrolledSkipList(const UnrolledSkipList& other)
+        : _alloc(std::allocator_traits<Allocator>::select_on_container_copy_construction(other._alloc)),
+          _block_alloc(_alloc),
+          _comp(other._comp),
+          _level_gen(other._level_gen)
+    {
+        initSentinels();
+        search_path last;
+        last.fill(head);
+        try
+        {
+            for (const Block* block = other.head->next(1); block != other.tail; block = block->next(1))
+            {
+                Block* clone = createBlock(block->height);
+                std::copy(block->keys, block->keys + block->count, clone->keys);
+                clone->count = block->count;
+                appendBlock(clone, last.data());
+            }
+        }catch(...)
+        {
+            destroyAll();
+            throw;
+        }
+    }
+    UnrolledSkipList(UnrolledSkipList&& other) noexcept
+        : _alloc(other._alloc),
+          _block_alloc(other._block_alloc),
+          _comp(std::move(other._comp)),
+          head(other.head),
+          tail(other.tail),
+          current_max_level(other.current_max_level),
+          _size(other._size),
+          _level_gen(other._level_gen)
+    {
+        other.initSentinels();
+        other.current_max_level = 1;
+        other._size = 0;
+    }
+    ~UnrolledSkipList() noexcept
+    {
+        destroyAll();
+    }
+    UnrolledSkipList& operator=(const UnrolledSkipList& other)
+    {
+        if (this != &other)
+        {
+            UnrolledSkipList temp(other);
+            swap(*this, temp);
+        }
+        return *this;
+    }
+    UnrolledSkipList& operator=(UnrolledSkipList&& other) noexcept
+    {
+        if (this != &other)
+        {
+            UnrolledSkipList temp(std::move(other));
+            swap(*this, temp);
+        }
+        return *this;
+    }
+
+    // Iterator access methods
+    const_iterator begin() const noexcept { return const_iterator(head->next(1), 0); }
+    const_iterator end() const noexcept { return const_iterator(tail, 0); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // Capacity
+    bool empty() const noexcept { return _size == 0; }
+    size_t size() const noexcept { return _size; }
+    // Number of linked blocks (memory use is about block_count() * BlockBytes)
+    size_t block_count() const noexcept
+    {
+        size_t count = 0;
+        for (const Block* block = head->next(1); block != tail; block = block->next(1)) ++count;
+        return count;
+    }
+    Allocator get_allocator() const { return _alloc; }
+
+    // Insert element
+    /*
+     * The key goes into the last block whose first key is not greater (the first
+     * block for a new minimum). A full block is split in half first: the upper half
+     * moves into a new tower linked right after it. Keys past the end of a full
+     * block start a new block instead, which keeps ascending inserts densely packed.
+     */
+    std::pair<iterator, bool> insert(const T& value)
+    {
+        Block* block = findBlock(value);
+        if (block == head) block = head->next(1);
+        if (block == tail)
+        {
+            block = createBlock(random_level());
+            search_path update;
+            update.fill(head);
+            linkBlock(block, update.data());
+        }
+        int index = blockLowerBound(block, value);
+        if (index < block->count && !_comp(value, block->keys[index]))
+        {
+            return {iterator(block, index), false};
+        }
+        if (block->count == static_cast<int>(BLOCK_KEYS))
+        {
+            // A key past the end of a full block opens a new one, so ascending runs leave full blocks
+            bool append = index == block->count;
+            int keep = append ? block->count : block->count / 2;
+            Block* upper = splitBlock(block, keep, append ? value : block->keys[keep]);
+            if (append || index > keep)
+            {
+                index -= keep;
+                block = upper;
+            }
+        }
+        std::copy_backward(block->keys + index, block->keys + block->count, block->keys + block->count + 1);
+        block->keys[index] = value;
+        ++block->count;
+        ++_size;
+        return {iterator(block, index), true};
+    }
+    // Range insert
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+        {
+            insert(*first);
+        }
+    }
+    // Erase by value
+    template <typename K>
+    bool erase(const K& key)
+    {
+        Block* block = findBlock(key);
+        if (block == head) return false;
+        int index = blockLowerBound(block, key);
+        if (index == block->count || _comp(key, block->keys[index])) return false;
+        removeAt(block, index);
+        return true;
+    }
+    // Erase by iterator, returns the position after the erased key
+    iterator erase(const_iterator pos)
+    {
+        if (pos == end())
+        {
+            throw std::out_of_range("Cannot erase end() iterator");
+        }
+        T key = *pos;
+        erase(key);
+        return upper_bound(key);
+    }
+    // Merge another list: keys missing here move over, duplicates stay in other
+    /*
+     * Both key sequences are swept once and rebuilt into densely packed blocks,
+     * O(n + m); the old blocks of both lists are released afterwards.
+     */
+    void merge(UnrolledSkipList&& other)
+    {
+        if (this == &other || other.empty()) return;
+        UnrolledSkipList merged(_level_gen, _comp, _alloc);
+        UnrolledSkipList left_over(other._level_gen, other._comp, other._alloc);
+        search_path merged_last;
+        search_path left_over_last;
+        merged_last.fill(merged.head);
+        left_over_last.fill(left_over.head);
+        const_iterator ours = begin();
+        const_iterator theirs = other.begin();
+        while (ours != end() && theirs != other.end())
+        {
+            if (_comp(*ours, *theirs))
+            {
+                merged.appendKey(*ours++, merged_last.data());
+            }else if (_comp(*theirs, *ours))
+            {
+                merged.appendKey(*theirs++, merged_last.data());
+            }else
+            {
+                merged.appendKey(*ours++, merged_last.data());
+                left_over.appendKey(*theirs++, left_over_last.data());
+            }
+        }
+        for (; ours != end(); ++ours) merged.appendKey(*ours, merged_last.data());
+        for (; theirs != other.end(); ++theirs) merged.appendKey(*theirs, merged_last.data());
+        swap(*this, merged);
+        swap(other, left_over);
+    }
+    void merge(UnrolledSkipList& other)
+    {
+        merge(std::move(other));
+    }
+
+    // Lookup operators
+    template <typename K>
+    const_iterator find(const K& key) const
+    {
+        const Block* block = findBlock(key);
+        if (block == head) return end();
+        int index = blockLowerBound(block, key);
+        if (index < block->count && !_comp(key, block->keys[index])) return const_iterator(block, index);
+        return end();
+    }
+    template <typename K>
+    bool contains(const K& key) const
+    {
+        return find(key) != end();
+    }
+    // First key not less than key
+    template <typename K>
+    const_iterator lower_bound(const K& key) const
+    {
+        const Block* block = findBlock(key);
+        if (block == head) return begin();
+        return positionIn(block, blockLowerBound(block, key));
+    }
+    // First key greater than key
+    template <typename K>
+    const_iterator upper_bound(const K& key) const
+    {
+        const Block* block = findBlock(key);
+        if (block == head) return begin();
+        return positionIn(block, blockUpperBound(block, key));
+    }
+
+    // Reset to empty state
+    void clear()
+    {
+        freeBlocks();
+        resetHead();
+        current_max_level = 1;
+        _size = 0;
+    }
+    friend void swap(UnrolledSkipList& a, UnrolledSkipList& b) noexcept
+    {
+        using std::swap;
+        swap(a.head, b.head);
+        swap(a.tail, b.tail);
+        swap(a.current_max_level, b.current_max_level);
+        swap(a._comp, b._comp);
+        swap(a._size, b._size);
+        swap(a._level_gen, b._level_gen);
+        if constexpr (std::allocator_traits<Allocator>::propagate_on_container_swap::value)
+        {
+            swap(a._alloc, b._alloc);
+            swap(a._block_alloc, b._block_alloc);
+        }
+    }
+    // Check if container is correct
+    bool validate() const
+    {
+        for (int lvl = 1; lvl <= current_max_level; ++lvl) {
+            for (const Block* block = head->next(lvl); block != tail; block = block->next(lvl)) {
+                if (block->height < lvl) {
+                    std::cerr << "Block too short at level " << lvl << std::endl;
+                    return false;
+                }
+                const Block* next_block = block->next(lvl);
+                if (next_block != tail && !_comp(block->keys[0], next_block->keys[0])) {
+                    std::cerr << "Block order violation at level " << lvl << std::endl;
+                    return false;
+                }
+            }
+        }
+        size_t count = 0;
+        const Block* prev = head;
+        const T* last_key = nullptr;
+        for (const Block* block = head->next(1); block != tail; prev = block, block = block->next(1)) {
+            if (block->left != prev) {
+                std::cerr << "Left link mismatch" << std::endl;
+                return false;
+            }
+            if (block->count < 1 || block->count > static_cast<int>(BLOCK_KEYS)) {
+                std::cerr << "Block fill out of range: " << block->count << std::endl;
+                return false;
+            }
+            for (int i = 0; i < block->count; ++i) {
+                if (last_key && !_comp(*last_key, block->keys[i])) {
+                    std::cerr << "Key order violation" << std::endl;
+                    return false;
+                }
+                last_key = &block->keys[i];
+            }
+            count += block->count;
+        }
+        if (tail->left != prev) {
+            std::cerr << "Tail link mismatch" << std::endl;
+            return false;
+        }
+        if (count != _size) {
+            std::cerr << "Size mismatch: " << count << " != " << _size << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    static constexpr int MAX_LVL = 16;
+    // Full blocks left by bulk building keep room for this many inserts before splitting
+    static constexpr int BULK_SLACK = static_cast<int>(BLOCK_KEYS / 8);
+    // Per-level predecessors of a search (index 0 unused)
+    using search_path = std::array<Block*, MAX_LVL + 1>;
+
+    Allocator _alloc;
+    block_allocator _block_alloc;
+    Compare _comp;
+    Block* head;
+    Block* tail;
+    int current_max_level = 1;
+    size_t _size = 0;
+    SkipLevelGenerator _level_gen;
+
+    // Number of link-sized allocation units occupied by a block of the given height
+    static constexpr size_t block_units(int height) noexcept
+    {
+        return (sizeof(Block) + height * sizeof(Block*) + sizeof(Block*) - 1) / sizeof(Block*);
+    }
+    Block* createBlock(int height)
+    {
+        Block** raw = std::allocator_traits<block_allocator>::allocate(_block_alloc, block_units(height));
+        Block* block = ::new (static_cast<void*>(raw)) Block{};
+        block->left = nullptr;
+        block->height = height;
+        block->count = 0;
+        for (int l = 1; l <= height; ++l)
+        {
+            block->next(l) = nullptr;
+        }
+        return block;
+    }
+    void deleteBlock(Block* block) noexcept
+    {
+        size_t units = block_units(block->height);
+        block->~Block();
+        std::allocator_traits<block_allocator>::deallocate(_block_alloc, reinterpret_cast<Block**>(block), units);
+    }
+    // Allocates head (spanning MAX_LVL levels) and tail sentinels of an empty list
+    void initSentinels()
+    {
+        head = createBlock(MAX_LVL);
+        try
+        {
+            tail = createBlock(1);
+        }catch(...)
+        {
+            deleteBlock(head);
+            throw;
+        }
+        resetHead();
+    }
+    void resetHead() noexcept
+    {
+        for (int l = 1; l <= MAX_LVL; ++l)
+        {
+            head->next(l) = tail;
+        }
+        tail->left = head;
+    }
+    // Frees the blocks between the sentinels
+    void freeBlocks() noexcept
+    {
+        Block* block = head->next(1);
+        while (block != tail)
+        {
+            Block* next_block = block->next(1);
+            deleteBlock(block);
+            block = next_block;
+        }
+    }
+    // Frees every block including sentinels
+    void destroyAll() noexcept
+    {
+        if (!head) return;
+        freeBlocks();
+        deleteBlock(head);
+        deleteBlock(tail);
+        head = tail = nullptr;
+    }
+    int random_level()
+    {
+        return _level_gen(MAX_LVL);
+    }
+    // Last block whose first key is not greater than key, head if there is none
+    template <typename K>
+    Block* findBlock(const K& key) const
+    {
+        Block* current = head;
+        for (int l = current_max_level; l >= 1; --l)
+        {
+            Block* next_block = current->next(l);
+            while (next_block != tail && !_comp(key, next_block->keys[0]))
+            {
+                current = next_block;
+                next_block = current->next(l);
+            }
+        }
+        return current;
+    }
+    // Records in update[l] the last block whose first key is less than key on every level
+    template <typename K>
+    void findPredecessors(const K& key, Block** update) const
+    {
+        Block* current = head;
+        for (int l = current_max_level; l >= 1; --l)
+        {
+            Block* next_block = current->next(l);
+            while (next_block != tail && _comp(next_block->keys[0], key))
+            {
+                current = next_block;
+                next_block = current->next(l);
+            }
+            update[l] = current;
+        }
+        std::fill(update + current_max_level + 1, update + MAX_LVL + 1, head);
+    }
+    // Arithmetic keys ordered by operator< are counted with a vector kernel: lanes,
+    // not branches, decide, and a sorted block needs nothing more than the count
+    template <typename K>
+    static constexpr bool simd_search = skiplist_simd::vectorized<T> && std::is_same_v<K, T> &&
+                                        (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>>);
+    // First index in block whose key is not less than key
+    /*
+     * Branchless binary search: the probe window halves every step and the
+     * comparison only selects the new base, so the loop runs log2(count) times
+     * without mispredicted branches.
+     */
+    template <typename K>
+    int blockLowerBound(const Block* block, const K& key) const
+    {
+        if constexpr (simd_search<K>)
+        {
+            return static_cast<int>(skiplist_simd::count_before(block->keys, block->count, key));
+        }
+        const T* base = block->keys;
+        int n = block->count;
+        if (n == 0) return 0;
+        while (n > 1)
+        {
+            int half = n / 2;
+            base = _comp(base[half], key) ? base + half : base;
+            n -= half;
+        }
+        return static_cast<int>(base - block->keys) + (_comp(*base, key) ? 1 : 0);
+    }
+    // First index in block whose key is greater than key
+    template <typename K>
+    int blockUpperBound(const Block* block, const K& key) const
+    {
+        if constexpr (simd_search<K>)
+        {
+            return block->count - static_cast<int>(skiplist_simd::count_after(block->keys, block->count, key));
+        }
+        const T* base = block->keys;
+        int n = block->count;
+        if (n == 0) return 0;
+        while (n > 1)
+        {
+            int half = n / 2;
+            base = !_comp(key, base[half]) ? base + half : base;
+            n -= half;
+        }
+        return static_cast<int>(base - block->keys) + (!_comp(key, *base) ? 1 : 0);
+    }
+    // Iterator to index in block, moving on to the next block past its last key
+    const_iterator positionIn(const Block* block, int index) const
+    {
+        if (index < block->count) return const_iterator(block, index);
+        return const_iterator(block->next(1), 0);
+    }
+    // Links block after update[l] on each of its levels
+    void linkBlock(Block* block, Block** update) noexcept
+    {
+        if (block->height > current_max_level)
+        {
+            current_max_level = block->height;
+        }
+        for (int l = 1; l <= block->height; ++l)
+        {
+            block->next(l) = update[l]->next(l);
+            update[l]->next(l) = block;
+        }
+        block->left = update[1];
+        block->next(1)->left = block;
+    }
+    // Links block at the end of the list; last[l] is the rightmost block of level l
+    void appendBlock(Block* block, Block** last) noexcept
+    {
+        linkBlock(block, last);
+        for (int l = 1; l <= block->height; ++l)
+        {
+            last[l] = block;
+        }
+        _size += block->count;
+    }
+    // Appends a key greater than every key in the list, opening a new block when the last is full
+    void appendKey(const T& key, Block** last)
+    {
+        Block* block = tail->left;
+        if (block == head || block->count >= static_cast<int>(BLOCK_KEYS) - BULK_SLACK)
+        {
+            block = createBlock(random_level());
+            appendBlock(block, last);
+        }
+        block->keys[block->count++] = key;
+        ++_size;
+    }
+    // Moves keys[keep..count) into a new block linked right after block;
+    // first_key is the first key the new block will hold
+    Block* splitBlock(Block* block, int keep, const T& first_key)
+    {
+        Block* upper = createBlock(random_level());
+        search_path update;
+        findPredecessors(first_key, update.data());
+        std::copy(block->keys + keep, block->keys + block->count, upper->keys);
+        upper->count = block->count - keep;
+        block->count = keep;
+        linkBlock(upper, update.data());
+        return upper;
+    }
+    // Removes keys[index]; empty blocks are unlinked, sparse ones absorb or join a neighbour
+    void removeAt(Block* block, int index)
+    {
+        T first_key = block->keys[0];
+        std::copy(block->keys + index + 1, block->keys + block->count, block->keys + index);
+        --block->count;
+        --_size;
+        if (block->count == 0)
+        {
+            unlinkBlock(block, first_key);
+            return;
+        }
+        if (block->count >= static_cast<int>(BLOCK_KEYS / 4)) return;
+        constexpr int merged_limit = static_cast<int>(BLOCK_KEYS * 3 / 4);
+        Block* next_block = block->next(1);
+        Block* prev_block = block->left;
+        if (next_block != tail && block->count + next_block->count <= merged_limit)
+        {
+            std::copy(next_block->keys, next_block->keys + next_block->count, block->keys + block->count);
+            block->count += next_block->count;
+            unlinkBlock(next_block, next_block->keys[0]);
+        }else if (prev_block != head && prev_block->count + block->count <= merged_limit)
+        {
+            std::copy(block->keys, block->keys + block->count, prev_block->keys + prev_block->count);
+            prev_block->count += block->count;
+            unlinkBlock(block, block->keys[0]);
+        }
+    }
+    // Unlinks and frees block; first_key is the first key it was linked under
+    void unlinkBlock(Block* block, const T& first_key)
+    {
+        search_path update;
+        findPredecessors(first_key, update.data());
+        for (int l = 1; l <= block->height; ++l)
+        {
+            update[l]->next(l) = block->next(l);
+        }
+        block->next(1)->left = block->left;
+        deleteBlock(block);
+        while (current_max_level > 1 && head->next(current_max_level) == tail)
+        {
+            --current_max_level;
+        }
+    }
+};
+
+// SkipList layout chosen by element type: sorted key blocks for trivially copyable
+// keys of at most 8 bytes, one tower per element otherwise
+template<typename T, typename Compare = std::less<>, typename Allocator = std::allocator<T>>
+using CompactSkipList = std::conditional_t<
+    std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T> && sizeof(T) <= 8,
+    UnrolledSkipList<T, Compare, Allocator>,
+    SkipList<T, Compare, Allocator>>;
+
+#endif
@@ -0,0 +1,379 @@
+/*
+ * VersionedSkipList.h - Skip list with multi-version snapshot reads
+ *
+ * Features:
+ * - Set-like API of SkipList: insert, erase, find, contains, lower_bound, upper_bound,
+ *   iteration over the current contents
+ * - Every insert and erase is stamped with the next sequence number (version())
+ * - snapshot() returns a read view fixed at the current version in O(log s) for s live
+ *   snapshots; its iterators only see entries inserted at or before that version and
+ *   not erased by then, whatever writes follow
+ * - Erased entries stay linked while a snapshot can still see them; they are freed in
+ *   erase order once every remaining snapshot is newer than their erase
+ *
+ * Snapshots do not make the list thread-safe: writers and readers still need external
+ * synchronization (use ConcurrentSkipList for concurrent access). A snapshot and its
+ * iterators must not outlive the list.
+ *
+ * Author: Ilya Pavlov (st129535@student.spbu.ru)
+ *
+ * VersionedSkipList Invariants:
+ * 1. Entries are ordered by key; entries of one key are ordered by version, at most one
+ *    of them is live (never erased)
+ * 2. An entry is visible at version v if born <= v < died
+ * 3. Every erased entry still linked was erased after the oldest live snapshot was taken,
+ *    and was visible to a live snapshot when erased
+ */
+#ifndef VERSIONED_SKIPLIST_H
+#define VERSIONED_SKIPLIST_H
+
+#include "SkipList.h"
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <utility>
+
+template<typename T, typename Compare = std::less<>, typename Allocator = std::allocator<T>>
+class VersionedSkipList
+{
+    // Element with the versions of its insert and erase
+    struct Entry
+    {
+        T value{};
+        uint64_t born = 0;
+        uint64_t died = 0;
+
+        Entry() = default;
+        template <typename V>
+        Entry(V&& v, uint64_t version) : value(std::forward<V>(v)), born(version), died(LIVE) {}
+
+        bool visible(uint64_t version) const noexcept { return born <= version && version < died; }
+    };
+    // Orders entries by key, in insertion order among the versions of one key
+    struct EntryCompare
+    {
+        using is_transparent = void;
+        using equivalent_keys = std::true_type;
+        [[no_unique_address]] Compare comp;
+
+        template <typename A, typename B>
+        bool operator()(const A& lhs, const B& rhs) const { return comp(keyOf(lhs), keyOf(rhs)); }
+        static const T& keyOf(const Entry& entry) noexcept { return entry.value; }
+        template <typename K>
+        static const K& keyOf(const K& key) noexcept { return key; }
+    };
+    using entry_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>;
+    using list_type = SkipList<Entry, EntryCompare, entry_allocator>;
+    using list_iterator = typename list_type::iterator;
+    using list_const_iterator = typename list_type::const_iterator;
+    // died of entries that were never erased
+    static constexpr uint64_t LIVE = UINT64_MAX;
+    // Version seen by iterators of the current contents: every entry is born at or
+    // before it, and only live entries die after it
+    static constexpr uint64_t CURRENT = LIVE - 1;
+
+public:
+    // Bidirectional iterator over the entries visible at one version
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return current->value; }
+        pointer operator->() const { return &current->value; }
+
+        const_iterator& operator++()
+        {
+            do ++current; while (current != last && !current->visible(version));
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+        // Stops at the first visible entry: decrementing that leaves the iterator in place
+        const_iterator& operator--()
+        {
+            for (list_const_iterator pos = current; pos != entries->cbegin();)
+            {
+                if ((--pos)->visible(version))
+                {
+                    current = pos;
+                    break;
+                }
+            }
+            return *this;
+        }
+        const_iterator operator--(int)
+        {
+            const_iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const { return current == other.current; }
+        bool operator!=(const const_iterator& other) const { return current != other.current; }
+
+    private:
+        friend class VersionedSkipList;
+        // Starts at pos or the first entry after it visible at version
+        const_iterator(list_const_iterator pos, const list_type* list, uint64_t at)
+            : current(pos), last(list->cend()), entries(list), version(at)
+        {
+            while (current != last && !current->visible(version)) ++current;
+        }
+        list_const_iterator current;
+        list_const_iterator last;
+        const list_type* entries = nullptr;
+        uint64_t version = CURRENT;
+    };
+    using iterator = const_iterator;
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = const T&;
+    using const_reference = const T&;
+
+    // Read view of the list at the version it was taken at
+    class Snapshot
+    {
+    public:
+        Snapshot(const Snapshot& other) : Snapshot(other.owner, other.at, other.count) {}
+        Snapshot(Snapshot&& other) noexcept : owner(std::exchange(other.owner, nullptr)), at(other.at), count(other.count) {}
+        Snapshot& operator=(Snapshot other) noexcept
+        {
+            std::swap(owner, other.owner);
+            std::swap(at, other.at);
+            std::swap(count, other.count);
+            return *this;
+        }
+        // Releasing the last snapshot of a version frees the entries only it could see
+        ~Snapshot()
+        {
+            if (owner) owner->release(at);
+        }
+
+        const_iterator begin() const { return owner->iteratorAt(owner->_list.begin(), at); }
+        const_iterator end() const { return owner->iteratorAt(owner->_list.end(), at); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+        template <typename K>
+        const_iterator find(const K& key) const { return owner->findAt(key, at); }
+        template <typename K>
+        bool contains(const K& key) const { return find(key) != end(); }
+        template <typename K>
+        const_iterator lower_bound(const K& key) const { return owner->iteratorAt(owner->_list.lower_bound(key), at); }
+        template <typename K>
+        const_iterator upper_bound(const K& key) const { return owner->iteratorAt(owner->_list.upper_bound(key), at); }
+        // Number of elements at the snapshot version
+        size_type size() const noexcept { return count; }
+        bool empty() const noexcept { return count == 0; }
+        uint64_t version() const noexcept { return at; }
+
+    private:
+        friend class VersionedSkipList;
+        Snapshot(VersionedSkipList* list, uint64_t version, size_type size) : owner(list), at(version), count(size)
+        {
+            if (owner) ++owner->_readers[at];
+        }
+        VersionedSkipList* owner;
+        uint64_t at;
+        size_type count;
+    };
+
+    // Constructor and destructor
+    explicit VersionedSkipList(const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : _list(EntryCompare{comp}, entry_allocator(alloc))
+    {
+    }
+    // Snapshots point back at their list, so it stays where it was built
+    VersionedSkipList(const VersionedSkipList&) = delete;
+    VersionedSkipList& operator=(const VersionedSkipList&) = delete;
+    ~VersionedSkipList() = default;
+
+    // Iterators over the current contents: they skip erased entries kept for snapshots
+    // and see later inserts
+    const_iterator begin() const { return iteratorAt(_list.begin(), CURRENT); }
+    const_iterator end() const { return iteratorAt(_list.end(), CURRENT); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    bool empty() const noexcept { return _size == 0; }
+    size_type size() const noexcept { return _size; }
+    // Sequence number of the last insert or erase
+    uint64_t version() const noexcept { return _version; }
+    // Erased entries kept linked for live snapshots
+    size_type retained() const noexcept { return _retired.size(); }
+
+    // Insert element
+    /*
+     * The new entry goes right behind the older versions of its key, found by one
+     * upper_bound descent; the last of them is the live one if the key is present.
+     */
+    std::pair<const_iterator, bool> insert(const T& value)
+    {
+        return insertEntry(value);
+    }
+    std::pair<const_iterator, bool> insert(T&& value)
+    {
+        return insertEntry(std::move(value));
+    }
+    // Erase element; the entry is freed at once unless a snapshot can still see it
+    template <typename K>
+    bool erase(const K& key)
+    {
+        list_iterator live = findLive(key);
+        if (live == _list.end()) return false;
+        retire(live);
+        return true;
+    }
+    // Erase by iterator over the current contents, returns the iterator following pos
+    const_iterator erase(const_iterator pos)
+    {
+        if (pos == end())
+        {
+            throw std::out_of_range("Cannot erase end() iterator");
+        }
+        if (pos.current->died != LIVE)
+        {
+            throw std::invalid_argument("Cannot erase an entry that is already erased");
+        }
+        const_iterator next = std::next(pos);
+        retire(findLive(*pos));
+        return next;
+    }
+    // Erase all elements (each erase gets its own version)
+    void clear()
+    {
+        for (list_iterator it = _list.begin(); it != _list.end();)
+        {
+            list_iterator next = std::next(it);
+            if (it->died == LIVE) retire(it);
+            it = next;
+        }
+    }
+
+    template <typename K>
+    const_iterator find(const K& key) const { return findAt(key, CURRENT); }
+    template <typename K>
+    bool contains(const K& key) const { return find(key) != end(); }
+    template <typename K>
+    const_iterator lower_bound(const K& key) const { return iteratorAt(_list.lower_bound(key), CURRENT); }
+    template <typename K>
+    const_iterator upper_bound(const K& key) const { return iteratorAt(_list.upper_bound(key), CURRENT); }
+
+    // Read view of the current contents, O(log s) for s live snapshots
+    Snapshot snapshot() { return Snapshot(this, _version, _size); }
+
+    // Check if the list and the version bookkeeping are consistent
+    bool validate() const
+    {
+        if (!_list.validate()) return false;
+        size_type live = 0;
+        for (const Entry& entry : _list)
+        {
+            if (entry.died == LIVE) ++live;
+            else if (expired(entry)) return false;
+        }
+        return live == _size && _list.size() == _size + _retired.size();
+    }
+
+private:
+    list_type _list;
+    uint64_t _version = 0;
+    size_type _size = 0;
+    // Versions of live snapshots, with the number of snapshots at each
+    std::map<uint64_t, size_type> _readers;
+    // Erased entries kept for snapshots, in the order of their erase versions
+    std::deque<list_iterator> _retired;
+
+    const_iterator iteratorAt(list_const_iterator pos, uint64_t version) const
+    {
+        return const_iterator(pos, &_list, version);
+    }
+    // The entry of key visible at version among the versions of that key
+    template <typename K>
+    const_iterator findAt(const K& key, uint64_t version) const
+    {
+        const EntryCompare comp = _list.key_comp();
+        for (list_const_iterator it = _list.lower_bound(key); it != _list.cend() && !comp(key, *it); ++it)
+        {
+            if (it->visible(version)) return iteratorAt(it, version);
+        }
+        return end();
+    }
+    // The live entry of key, the last of its versions if present
+    template <typename K>
+    list_iterator findLive(const K& key)
+    {
+        list_iterator after = _list.upper_bound(key);
+        if (after == _list.begin()) return _list.end();
+        list_iterator last = std::prev(after);
+        return (last->died == LIVE && !_list.key_comp()(last->value, key)) ? last : _list.end();
+    }
+    template <typename V>
+    std::pair<const_iterator, bool> insertEntry(V&& value)
+    {
+        list_iterator after = _list.upper_bound(value);
+        if (after != _list.begin())
+        {
+            list_iterator last = std::prev(after);
+            if (last->died == LIVE && !_list.key_comp()(last->value, value))
+            {
+                return {iteratorAt(last, CURRENT), false};
+            }
+        }
+        list_iterator inserted = _list.insert(after, Entry(std::forward<V>(value), _version + 1));
+        ++_version;
+        ++_size;
+        return {iteratorAt(inserted, CURRENT), true};
+    }
+    // True if a live snapshot can see the erased entry
+    bool seen(const Entry& entry) const
+    {
+        auto reader = _readers.lower_bound(entry.born);
+        return reader != _readers.end() && reader->first < entry.died;
+    }
+    // Stamps the live entry at pos as erased and frees it unless a snapshot can see it
+    void retire(list_iterator pos)
+    {
+        pos->died = ++_version;
+        --_size;
+        if (seen(*pos))
+        {
+            _retired.push_back(pos);
+        }else
+        {
+            _list.erase(pos);
+        }
+    }
+    // True once every live snapshot was taken at or after the entry was erased
+    bool expired(const Entry& entry) const
+    {
+        return _readers.empty() || entry.died <= _readers.begin()->first;
+    }
+    // Drops a snapshot and frees the erased entries older than the oldest remaining one,
+    // from the front of _retired: O(1) amortized per release
+    void release(uint64_t version)
+    {
+        auto reader = _readers.find(version);
+        if (--reader->second == 0) _readers.erase(reader);
+        while (!_retired.empty() && expired(*_retired.front()))
+        {
+            _list.erase(_retired.front());
+            _retired.pop_front();
+        }
+    }
+};
+
+#endif
@@ -1,8 +1,54 @@
 #include "SkipList.h"
+#include "SkipListArena.h"
+#include "ConcurrentSkipList.h"
+#include "UnrolledSkipList.h"
+#include "SkipMap.h"
+#include "VersionedSkipList.h"
+#include "SkipListMmap.h"
+#include "ShardedSkipList.h"
+#include "SingleWriterSkipList.h"
+#include "StaticSkipList.h"
+#include "StringSkipList.h"
 #include <gtest/gtest.h>
 #include <vector>
 #include <algorithm>
 #include <random>
+#include <set>
+#include <map>
+#include <numeric>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <sstream>
+#include <string_view>
+#include <iterator>
+#include <ranges>
+#include <fstream>
+#include <cstdio>
+#include <limits>
+#include <sys/wait.h>
+
+// Element type counting copies and constructions, ordered by key
+struct Record {
+    static inline int copies = 0;
+    static inline int constructed = 0;
+    std::string key;
+    std::string payload;
+
+    Record() = default;
+    Record(std::string k, std::string p) : key(std::move(k)), payload(std::move(p)) { ++constructed; }
+    Record(const Record& other) : key(other.key), payload(other.payload) { ++copies; }
+    Record(Record&&) noexcept = default;
+    Record& operator=(const Record& other) { key = other.key; payload = other.payload; ++copies; return *this; }
+    Record& operator=(Record&&) noexcept = default;
+};
+
+struct RecordLess {
+    using is_transparent = void;
+    bool operator()(const Record& a, const Record& b) const { return a.key < b.key; }
+    bool operator()(const Record& a, const std::string& b) const { return a.key < b; }
+    bool operator()(const std::string& a, const Record& b) const { return a < b.key; }
+};
 
 class SkipListTest : public ::testing::Test {
 protected:
@@ -76,6 +122,276 @@ TEST_F(SkipListTest, MultipleInsertRandom) {
     }
 }
 
+TEST_F(SkipListTest, InsertReturnsPosition) {
+    for (int i = 0; i < 200; i += 2) {
+        sl_int->insert(i);
+    }
+    auto [it, inserted] = sl_int->insert(51);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*it, 51);
+    EXPECT_EQ(*++it, 52);
+
+    auto [dup, dup_inserted] = sl_int->insert(52);
+    EXPECT_FALSE(dup_inserted);
+    EXPECT_EQ(dup, it);
+    EXPECT_TRUE(sl_int->validate());
+}
+
+TEST_F(SkipListTest, HintedInsert) {
+    for (int i = 0; i < 100; ++i) {
+        auto it = sl_int->insert(sl_int->cend(), i);
+        EXPECT_EQ(*it, i);
+    }
+    auto it = sl_int->insert(sl_int->find(50), 40);  // wrong hint falls back
+    EXPECT_EQ(*it, 40);
+    EXPECT_EQ(sl_int->size(), 100);
+    it = sl_int->insert(sl_int->cbegin(), -1);
+    EXPECT_EQ(it, sl_int->begin());
+    EXPECT_EQ(sl_int->size(), 101);
+    EXPECT_TRUE(sl_int->validate());
+}
+
+TEST_F(SkipListTest, HintedLookups) {
+    for (int i = 0; i < 200; i += 2) {
+        sl_int->insert(i);
+    }
+    auto hint = sl_int->find(50);
+    EXPECT_EQ(*sl_int->find_from(hint, 120), 120);
+    EXPECT_TRUE(sl_int->find_from(hint, 121) == sl_int->end());
+    EXPECT_EQ(*sl_int->find_from(hint, 10), 10);
+    EXPECT_EQ(*sl_int->lower_bound_from(hint, 51), 52);
+    EXPECT_EQ(*sl_int->lower_bound_from(hint, 48), 48);
+    EXPECT_TRUE(sl_int->lower_bound_from(sl_int->cend(), 1000) == sl_int->end());
+    EXPECT_EQ(*sl_int->lower_bound_from(sl_int->cend(), -5), 0);
+}
+
+TEST_F(SkipListTest, FingerSearch) {
+    sl_int->use_finger(true);
+    EXPECT_TRUE(sl_int->uses_finger());
+    std::set<int> reference;
+    std::mt19937 gen(3);
+    int cursor = 0;
+    for (int i = 0; i < 20000; ++i) {
+        cursor += static_cast<int>(gen() % 7) - 2;
+        switch (gen() % 5) {
+        case 0:
+        case 1:
+            EXPECT_EQ(sl_int->insert(cursor).second, reference.insert(cursor).second);
+            break;
+        case 2:
+            EXPECT_EQ(sl_int->erase(cursor), reference.erase(cursor) > 0);
+            break;
+        case 3:
+            EXPECT_EQ(sl_int->contains(cursor), reference.count(cursor) > 0);
+            break;
+        default:
+            sl_int->insert(sl_int->cend(), cursor + 100);
+            reference.insert(cursor + 100);
+            break;
+        }
+    }
+    EXPECT_TRUE(sl_int->validate());
+    EXPECT_TRUE(std::equal(sl_int->begin(), sl_int->end(), reference.begin(), reference.end()));
+
+    SkipList<int> copy(*sl_int);
+    EXPECT_TRUE(copy.uses_finger());
+    copy.clear();
+    copy.insert(1);
+    EXPECT_TRUE(copy.contains(1));
+}
+
+TEST_F(SkipListTest, BatchedLookups) {
+    std::mt19937 gen(5);
+    // The second size is large enough for the interleaved batch path
+    for (int n : {300, 100000}) {
+        std::vector<int> evens(n);
+        for (int i = 0; i < n; ++i) evens[i] = 2 * i;
+        sl_int->assign_sorted(evens.begin(), evens.end());
+
+        std::vector<int> probes(2000);
+        for (int& p : probes) p = static_cast<int>(gen() % (2 * n + 10)) - 5;
+        probes.push_back(probes.front());
+
+        std::vector<SkipList<int>::iterator> found;
+        sl_int->find_batch(probes.begin(), probes.end(), std::back_inserter(found));
+        std::vector<char> present(probes.size());
+        sl_int->contains_batch(probes.begin(), probes.end(), present.begin());
+        ASSERT_EQ(found.size(), probes.size());
+        for (size_t i = 0; i < probes.size(); ++i) {
+            EXPECT_EQ(found[i], sl_int->find(probes[i]));
+            EXPECT_EQ(present[i] != 0, sl_int->contains(probes[i]));
+        }
+
+        std::sort(probes.begin(), probes.end());
+        const SkipList<int>& view = *sl_int;
+        std::vector<SkipList<int>::const_iterator> sorted_found(probes.size());
+        view.find_batch(probes.begin(), probes.end(), sorted_found.begin());
+        for (size_t i = 0; i < probes.size(); ++i) {
+            EXPECT_EQ(sorted_found[i], view.find(probes[i]));
+        }
+    }
+}
+
+TEST_F(SkipListTest, SortedBulkBuild) {
+    std::vector<int> nums(1000);
+    std::iota(nums.begin(), nums.end(), 0);
+
+    SkipList<int> built(sorted_unique, nums.begin(), nums.end());
+    EXPECT_EQ(built.size(), nums.size());
+    EXPECT_TRUE(std::equal(built.begin(), built.end(), nums.begin(), nums.end()));
+    EXPECT_TRUE(built.validate());
+
+    sl_int->insert(5000);
+    sl_int->assign_sorted(nums.begin(), nums.end(), true);
+    EXPECT_EQ(sl_int->size(), nums.size());
+    EXPECT_FALSE(sl_int->contains(5000));
+    EXPECT_TRUE(sl_int->contains(999));
+    EXPECT_TRUE(sl_int->validate());
+}
+
+TEST_F(SkipListTest, SaveLoadRoundTrip) {
+    std::mt19937 gen(23);
+    for (int i = 0; i < 5000; ++i) {
+        sl_int->insert(static_cast<int>(gen()));
+    }
+    sl_int->insert(std::numeric_limits<int>::min());
+    sl_int->insert(std::numeric_limits<int>::max());
+
+    for (bool varint : {true, false}) {
+        std::stringstream stream;
+        sl_int->save(stream, {.varint_keys = varint, .tower_heights = true});
+        SkipList<int> loaded;
+        loaded.insert(7);
+        loaded.reset_stats();
+        loaded.load(stream);
+        EXPECT_TRUE(loaded == *sl_int);
+        EXPECT_TRUE(loaded.validate());
+        // Saved heights rebuild the same structure without a single search
+        EXPECT_EQ(loaded.stats().level_histogram, sl_int->stats().level_histogram);
+        EXPECT_EQ(loaded.stats().searches, 0);
+    }
+
+    // Dense keys take about a byte each
+    std::vector<long long> dense(10000);
+    std::iota(dense.begin(), dense.end(), -5000LL);
+    IndexableSkipList<long long, std::greater<>> descending(sorted_unique, dense.rbegin(), dense.rend());
+    std::stringstream compact;
+    descending.save(compact);
+    EXPECT_LT(compact.str().size(), dense.size() + 16);
+    IndexableSkipList<long long, std::greater<>> reloaded;
+    reloaded.load(compact);
+    EXPECT_TRUE(reloaded == descending);
+    EXPECT_EQ(*reloaded.nth(100), 4899);
+    EXPECT_TRUE(reloaded.validate());
+
+    SkipList<std::string> words;
+    for (const char* word : {"", "delta", "alpha", "a much longer word than the others"}) {
+        words.insert(word);
+    }
+    std::stringstream text;
+    words.save(text);
+    SkipList<std::string> words_loaded;
+    words_loaded.load(text);
+    EXPECT_TRUE(words_loaded == words);
+}
+
+TEST_F(SkipListTest, LoadRejectsBadStreams) {
+    for (int i = 0; i < 100; ++i) {
+        sl_int->insert(i * 3);
+    }
+    std::stringstream stream;
+    sl_int->save(stream, {.tower_heights = true});
+    const std::string saved = stream.str();
+
+    SkipList<int> loaded;
+    std::istringstream truncated(saved.substr(0, saved.size() - 10));
+    EXPECT_THROW(loaded.load(truncated), std::invalid_argument);
+    EXPECT_TRUE(loaded.empty());
+    EXPECT_TRUE(loaded.validate());
+
+    std::istringstream garbage("not a list");
+    EXPECT_THROW(loaded.load(garbage), std::invalid_argument);
+
+    SkipList<short> narrow;
+    std::istringstream other_type(saved);
+    EXPECT_THROW(narrow.load(other_type), std::invalid_argument);
+
+    SkipList<int, std::greater<>> reversed;
+    std::istringstream out_of_order(saved);
+    EXPECT_THROW(reversed.load(out_of_order), std::invalid_argument);
+    EXPECT_TRUE(reversed.empty());
+}
+
+TEST_F(SkipListTest, RangeViews) {
+    for (int i = 0; i < 100; ++i) {
+        sl_int->insert(i * 2);
+    }
+    auto window = sl_int->range(10, 21);
+    static_assert(std::ranges::view<decltype(window)>);
+    static_assert(std::ranges::bidirectional_range<decltype(window)>);
+    std::vector<int> expected{10, 12, 14, 16, 18, 20};
+    EXPECT_TRUE(std::ranges::equal(window, expected));
+    EXPECT_TRUE(sl_int->range(11, 11).empty());
+    EXPECT_TRUE(sl_int->range(50, 10).empty());
+    EXPECT_TRUE(std::ranges::equal(sl_int->range(190, 1000), std::vector<int>{190, 192, 194, 196, 198}));
+
+    // Composes lazily: stops after the third match without reaching hi
+    auto multiples = sl_int->range(0, 1000)
+                   | std::views::filter([](int v) { return v % 3 == 0; })
+                   | std::views::take(3);
+    EXPECT_TRUE(std::ranges::equal(multiples, std::vector<int>{0, 6, 12}));
+
+    // Mutable view writes through
+    SkipList<Record, RecordLess> records;
+    records.emplace("a", "1");
+    records.emplace("b", "2");
+    records.emplace("c", "3");
+    for (Record& record : records.range(std::string("b"), std::string("z"))) {
+        record.payload += "!";
+    }
+    EXPECT_EQ(records.find(std::string("a"))->payload, "1");
+    EXPECT_EQ(records.find(std::string("c"))->payload, "3!");
+
+    const SkipList<int>& view = *sl_int;
+    auto [first, last] = view.equal_range(42);
+    EXPECT_EQ(*first, 42);
+    EXPECT_EQ(std::next(first), last);
+    EXPECT_TRUE(view.equal_range(43).empty());
+
+    SkipMultiMap<int, int> multi;
+    for (int i = 0; i < 5; ++i) {
+        multi.insert({1, i});
+        multi.insert({2, i});
+    }
+    auto [lo, hi] = multi.equal_range(1);
+    EXPECT_EQ(std::distance(lo, hi), 5);
+    EXPECT_EQ(hi->first, 2);
+    EXPECT_EQ(std::ranges::distance(multi.range(1, 3)), 10);
+}
+
+TEST(SkipListRecordTest, MoveInsertAndEmplace) {
+    SkipList<Record, RecordLess> sl;
+    Record::copies = 0;
+    Record::constructed = 0;
+
+    sl.insert(Record("b", std::string(200, 'x')));
+    sl.emplace("a", std::string(200, 'y'));
+    sl.emplace("c", "z");
+    EXPECT_EQ(Record::copies, 0);
+    EXPECT_EQ(Record::constructed, 3);
+
+    auto [it, inserted] = sl.try_emplace(std::string("a"), "a", "ignored");
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(it->payload, std::string(200, 'y'));
+    EXPECT_EQ(Record::constructed, 3);
+
+    auto [it2, inserted2] = sl.try_emplace(std::string("d"), "d", "new");
+    EXPECT_TRUE(inserted2);
+    EXPECT_EQ(it2->payload, "new");
+    EXPECT_EQ(Record::copies, 0);
+    EXPECT_EQ(sl.size(), 4);
+}
+
 // Erase Tests
 TEST_F(SkipListTest, SingleErase) {
     sl_int->insert(42);
@@ -110,6 +426,191 @@ TEST_F(SkipListTest, MultipleErase) {
     }
 }
 
+TEST_F(SkipListTest, EraseByIterator) {
+    for (int i = 0; i < 10; ++i) {
+        sl_int->insert(i);
+    }
+    auto it = sl_int->erase(sl_int->find(4));
+    EXPECT_EQ(*it, 5);
+    EXPECT_EQ(sl_int->size(), 9);
+    EXPECT_THROW(sl_int->erase(sl_int->end()), std::out_of_range);
+#if SKIPLIST_DEBUG_CHECKS
+    SkipList<int> other;
+    other.insert(5);
+    EXPECT_THROW(sl_int->erase(other.begin()), std::invalid_argument);
+#endif
+    EXPECT_TRUE(sl_int->validate());
+}
+
+TEST_F(SkipListTest, RangeErase) {
+    for (int i = 0; i < 1000; ++i) {
+        sl_int->insert(i);
+    }
+    auto it = sl_int->erase(sl_int->find(100), sl_int->find(900));
+    EXPECT_EQ(*it, 900);
+    EXPECT_EQ(sl_int->size(), 200);
+    EXPECT_FALSE(sl_int->contains(500));
+    EXPECT_TRUE(sl_int->contains(99));
+    EXPECT_TRUE(sl_int->validate());
+
+    it = sl_int->erase(sl_int->find(950), sl_int->cend());
+    EXPECT_TRUE(it == sl_int->end());
+    EXPECT_EQ(sl_int->size(), 150);
+    it = sl_int->erase(sl_int->cbegin(), sl_int->cbegin());
+    EXPECT_EQ(*it, 0);
+    EXPECT_EQ(sl_int->size(), 150);
+
+    it = sl_int->erase(sl_int->cbegin(), sl_int->cend());
+    EXPECT_TRUE(it == sl_int->end());
+    EXPECT_TRUE(sl_int->empty());
+    EXPECT_TRUE(sl_int->validate());
+    sl_int->insert(7);
+    EXPECT_TRUE(sl_int->contains(7));
+}
+
+TEST_F(SkipListTest, SplitAndJoin) {
+    for (int i = 0; i < 1000; ++i) {
+        sl_int->insert(i);
+    }
+    SkipList<int> upper = sl_int->split(600);
+    EXPECT_EQ(sl_int->size(), 600);
+    EXPECT_EQ(upper.size(), 400);
+    EXPECT_EQ(*upper.begin(), 600);
+    EXPECT_TRUE(sl_int->upper_bound(599) == sl_int->end());
+    EXPECT_TRUE(sl_int->validate());
+    EXPECT_TRUE(upper.validate());
+
+    SkipList<int> rest = upper.split(-5);
+    EXPECT_TRUE(upper.empty());
+    EXPECT_EQ(rest.size(), 400);
+    EXPECT_TRUE(sl_int->split(5000).empty());
+
+    SkipList<int> overlapping;
+    overlapping.insert(700);
+    EXPECT_THROW(rest.join(std::move(overlapping)), std::invalid_argument);
+    EXPECT_EQ(overlapping.size(), 1);
+    rest.join(std::move(*sl_int));
+    EXPECT_TRUE(sl_int->empty());
+    EXPECT_EQ(rest.size(), 1000);
+    EXPECT_TRUE(rest.validate());
+    int expected = 0;
+    for (int v : rest) {
+        EXPECT_EQ(v, expected++);
+    }
+    SkipList<int> tail_part;
+    tail_part.insert(2000);
+    rest.join(std::move(tail_part));
+    EXPECT_EQ(*rest.upper_bound(999), 2000);
+    EXPECT_TRUE(rest.validate());
+
+    // Separate arenas cannot trade towers: the elements are inserted instead
+    SkipList<int, std::less<>, SkipListArenaAllocator<int>> first_arena, second_arena;
+    first_arena.insert(1);
+    second_arena.insert(2);
+    first_arena.join(std::move(second_arena));
+    EXPECT_EQ(first_arena.size(), 2);
+    EXPECT_TRUE(second_arena.empty());
+}
+
+TEST_F(SkipListTest, IteratorsFollowSplitAndJoin) {
+    for (int i = 0; i < 20; ++i) {
+        sl_int->insert(i);
+    }
+    auto it = sl_int->find(15);
+    SkipList<int> upper = sl_int->split(10);
+#if SKIPLIST_DEBUG_CHECKS
+    EXPECT_THROW(sl_int->erase(upper.find(16)), std::invalid_argument);
+#endif
+    EXPECT_EQ(*upper.erase(it), 16);
+    EXPECT_FALSE(upper.contains(15));
+
+    SkipList<int> more;
+    more.insert(30);
+    more.insert(31);
+    auto jt = more.find(30);
+    upper.join(std::move(more));
+    EXPECT_EQ(*upper.erase(jt), 31);
+    sl_int->join(std::move(upper));
+    auto kt = sl_int->find(31);
+    EXPECT_TRUE(sl_int->erase(kt) == sl_int->end());
+    EXPECT_EQ(sl_int->size(), 19);
+    EXPECT_TRUE(sl_int->validate());
+}
+
+TEST_F(SkipListTest, MergeSplicesTowers) {
+    SkipList<Record, RecordLess> target;
+    SkipList<Record, RecordLess> source;
+    for (int i = 0; i < 300; ++i) {
+        target.emplace(std::to_string(2 * i), "target");
+        source.emplace(std::to_string(3 * i), "source");
+    }
+    SkipList<Record, RecordLess> replaced(target);
+    SkipList<Record, RecordLess> replacing(source);
+    Record::copies = 0;
+    target.merge(std::move(source));
+    EXPECT_EQ(Record::copies, 0);
+    EXPECT_EQ(target.size(), 500);
+    EXPECT_EQ(source.size(), 100);
+    EXPECT_EQ(target.find(std::string("6"))->payload, "target");
+    EXPECT_EQ(source.find(std::string("6"))->payload, "source");
+    EXPECT_TRUE(target.validate());
+    EXPECT_TRUE(source.validate());
+
+    replaced.merge(std::move(replacing), merge_policy::replace_existing);
+    EXPECT_EQ(replaced.size(), 500);
+    EXPECT_EQ(replaced.find(std::string("6"))->payload, "source");
+    EXPECT_EQ(replaced.find(std::string("2"))->payload, "target");
+    EXPECT_EQ(replacing.find(std::string("6"))->payload, "target");
+    EXPECT_TRUE(replaced.validate());
+}
+
+TEST_F(SkipListTest, SetAlgebra) {
+    std::set<int> a_ref, b_ref;
+    SkipList<int> a, b;
+    std::mt19937 gen(11);
+    for (int i = 0; i < 2000; ++i) {
+        int key = gen() % 3000;
+        if (gen() % 2) {
+            a.insert(key);
+            a_ref.insert(key);
+        } else {
+            b.insert(key);
+            b_ref.insert(key);
+        }
+    }
+    auto check = [](const SkipList<int>& result, const std::vector<int>& expected) {
+        EXPECT_TRUE(result.validate());
+        EXPECT_TRUE(std::equal(result.begin(), result.end(), expected.begin(), expected.end()));
+    };
+    std::vector<int> expected;
+    std::set_union(a_ref.begin(), a_ref.end(), b_ref.begin(), b_ref.end(), std::back_inserter(expected));
+    check(set_union(a, b), expected);
+    expected.clear();
+    std::set_intersection(a_ref.begin(), a_ref.end(), b_ref.begin(), b_ref.end(), std::back_inserter(expected));
+    check(set_intersection(a, b), expected);
+    expected.clear();
+    std::set_difference(a_ref.begin(), a_ref.end(), b_ref.begin(), b_ref.end(), std::back_inserter(expected));
+    check(set_difference(a, b), expected);
+    expected.clear();
+    std::set_symmetric_difference(a_ref.begin(), a_ref.end(), b_ref.begin(), b_ref.end(), std::back_inserter(expected));
+    check(set_symmetric_difference(a, b), expected);
+    EXPECT_TRUE(set_intersection(a, SkipList<int>()).empty());
+
+    IndexableSkipList<int> c, d;
+    for (int i = 0; i < 100; ++i) {
+        c.insert(i);
+        d.insert(i + 50);
+    }
+    IndexableSkipList<int> both = set_union(c, d);
+    EXPECT_TRUE(both.validate());
+    EXPECT_EQ(both.rank(120), 120);
+    c.merge(d);
+    EXPECT_TRUE(c.validate());
+    EXPECT_EQ(c.size(), 150);
+    EXPECT_EQ(d.size(), 50);
+    EXPECT_EQ(*c.nth(140), 140);
+}
+
 // Iterator Tests
 TEST_F(SkipListTest, IteratorTraversal) {
     std::vector<int> nums = {3, 1, 4, 1, 5, 9, 2, 6};
@@ -129,6 +630,32 @@ TEST_F(SkipListTest, IteratorTraversal) {
     EXPECT_EQ(it, sl_int->end());
 }
 
+TEST_F(SkipListTest, ReverseIteration) {
+    static_assert(std::bidirectional_iterator<SkipList<int>::iterator>);
+    static_assert(std::bidirectional_iterator<SkipList<int>::const_iterator>);
+    static_assert(std::ranges::bidirectional_range<const SkipList<int>>);
+
+    EXPECT_TRUE(sl_int->rbegin() == sl_int->rend());
+    for (int i = 0; i < 100; ++i) {
+        sl_int->insert(i);
+    }
+    int expected = 99;
+    for (auto it = sl_int->rbegin(); it != sl_int->rend(); ++it) {
+        EXPECT_EQ(*it, expected--);
+    }
+    EXPECT_EQ(expected, -1);
+
+    sl_int->erase(sl_int->find(90), sl_int->cend());
+    EXPECT_EQ(*std::prev(sl_int->end()), 89);
+    auto it = sl_int->find(50);
+    EXPECT_EQ(*it--, 50);
+    EXPECT_EQ(*it, 49);
+    EXPECT_EQ(*++it, 50);
+    const SkipList<int>& view = *sl_int;
+    EXPECT_EQ(*view.crbegin(), 89);
+    EXPECT_EQ(std::distance(view.rbegin(), view.rend()), 90);
+}
+
 TEST_F(SkipListTest, ConstIterator) {
     sl_int->insert(42);
     const SkipList<int>& const_sl = *sl_int;
@@ -201,6 +728,29 @@ TEST_F(SkipListTest, CopyConstructor) {
     EXPECT_TRUE(copy.validate());
 }
 
+TEST_F(SkipListTest, CopyAssignment) {
+    for (int i = 0; i < 50; ++i) {
+        sl_int->insert(i);
+    }
+    SkipList<int> bigger;
+    for (int i = 100; i < 300; ++i) {
+        bigger.insert(i);
+    }
+    SkipList<int> smaller;
+    smaller.insert(-1);
+
+    const SkipList<int>& source = *sl_int;
+    bigger = source;
+    smaller = source;
+    EXPECT_TRUE(bigger == source);
+    EXPECT_TRUE(smaller == source);
+    EXPECT_TRUE(bigger.validate());
+    EXPECT_TRUE(smaller.validate());
+
+    bigger.insert(1000);
+    EXPECT_FALSE(sl_int->contains(1000));
+}
+
 TEST_F(SkipListTest, MoveConstructor) {
     for (int i = 0; i < 10; ++i) {
         sl_int->insert(i);
@@ -212,6 +762,1520 @@ TEST_F(SkipListTest, MoveConstructor) {
     EXPECT_TRUE(moved.validate());
 }
 
+TEST_F(SkipListTest, ClearAndReuse) {
+    for (int i = 0; i < 100; ++i) {
+        sl_int->insert(i);
+    }
+    sl_int->clear();
+    EXPECT_TRUE(sl_int->empty());
+    EXPECT_EQ(sl_int->begin(), sl_int->end());
+    EXPECT_TRUE(sl_int->validate());
+
+    sl_int->insert(7);
+    EXPECT_EQ(sl_int->size(), 1);
+    EXPECT_EQ(*sl_int->begin(), 7);
+    EXPECT_TRUE(sl_int->validate());
+}
+
+// Indexable Tests
+TEST(IndexableSkipListTest, RankAndSelect) {
+    IndexableSkipList<int> sl;
+    std::set<int> reference;
+    std::mt19937 gen(7);
+    for (int i = 0; i < 3000; ++i) {
+        int key = gen() % 1000;
+        if (gen() % 3) {
+            sl.insert(key);
+            reference.insert(key);
+        } else {
+            EXPECT_EQ(sl.erase(key), reference.erase(key) > 0);
+        }
+    }
+    EXPECT_TRUE(sl.validate());
+
+    std::vector<int> sorted(reference.begin(), reference.end());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        EXPECT_EQ(*sl.nth(i), sorted[i]);
+        EXPECT_EQ(sl.rank(sorted[i]), i);
+    }
+    EXPECT_TRUE(sl.nth(sorted.size()) == sl.end());
+    EXPECT_EQ(sl.count_range(100, 300),
+              static_cast<size_t>(std::distance(reference.lower_bound(100), reference.lower_bound(300))));
+    EXPECT_EQ(sl.count_range(300, 100), 0);
+    EXPECT_EQ(sl.distance(sl.nth(5), sl.end()), static_cast<std::ptrdiff_t>(sorted.size() - 5));
+    EXPECT_EQ(sl.index_of(sl.find(sorted[42])), 42);
+}
+
+// Orders pairs by their first member, keeping pairs with equal firsts side by side
+struct FirstLess {
+    using equivalent_keys = std::true_type;
+    bool operator()(const std::pair<int, int>& lhs, const std::pair<int, int>& rhs) const {
+        return lhs.first < rhs.first;
+    }
+};
+
+TEST(IndexableSkipListTest, PositionsAmongEquivalents) {
+    IndexableSkipList<std::pair<int, int>, FirstLess> sl;
+    sl.insert({3, 0});
+    for (int i = 0; i < 5; ++i) {
+        sl.insert({7, i});
+    }
+    sl.insert({9, 0});
+    auto it = sl.begin();
+    for (size_t i = 0; i < sl.size(); ++i, ++it) {
+        EXPECT_EQ(sl.index_of(it), i);
+    }
+    EXPECT_EQ(sl.index_of(sl.end()), sl.size());
+    EXPECT_EQ(std::next(sl.begin(), 4)->second, 3);
+    EXPECT_EQ(sl.distance(std::next(sl.begin()), std::next(sl.begin(), 4)), 3);
+    EXPECT_EQ(sl.distance(std::next(sl.begin(), 4), sl.end()), 3);
+}
+
+TEST(IndexableSkipListTest, BulkPathsKeepWidths) {
+    std::vector<int> sorted(500);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    IndexableSkipList<int> built(sorted_unique, sorted.begin(), sorted.end());
+    EXPECT_TRUE(built.validate());
+    EXPECT_EQ(*built.nth(123), 123);
+
+    IndexableSkipList<int> copy(built);
+    EXPECT_TRUE(copy.validate());
+    IndexableSkipList<int> assigned;
+    assigned.insert(-1);
+    assigned = built;
+    EXPECT_TRUE(assigned.validate());
+    EXPECT_EQ(assigned.rank(250), 250);
+
+    built.assign_sorted(sorted.begin(), sorted.end(), true);
+    built.insert(built.cend(), 1000);
+    EXPECT_TRUE(built.validate());
+    EXPECT_EQ(built.rank(1000), 500);
+    built.clear();
+    EXPECT_TRUE(built.validate());
+    EXPECT_TRUE(built.nth(0) == built.end());
+}
+
+TEST(IndexableSkipListTest, SplitJoinKeepWidths) {
+    IndexableSkipList<int> sl;
+    for (int i = 0; i < 2000; ++i) {
+        sl.insert(i);
+    }
+    sl.erase(sl.nth(100), sl.nth(300));
+    EXPECT_TRUE(sl.validate());
+    EXPECT_EQ(*sl.nth(100), 300);
+
+    IndexableSkipList<int> upper = sl.split(1000);
+    EXPECT_TRUE(sl.validate());
+    EXPECT_TRUE(upper.validate());
+    EXPECT_EQ(sl.size(), 800);
+    EXPECT_EQ(upper.rank(1500), 500);
+
+    upper.join(std::move(sl));
+    EXPECT_TRUE(upper.validate());
+    EXPECT_EQ(upper.size(), 1800);
+    EXPECT_EQ(upper.rank(1500), 1300);
+    EXPECT_EQ(*upper.nth(150), 350);
+}
+
+// Unrolled Tests
+TEST(UnrolledSkipListTest, MatchesStdSet) {
+    static_assert(std::is_same_v<CompactSkipList<int>, UnrolledSkipList<int>>);
+    static_assert(std::is_same_v<CompactSkipList<std::string>, SkipList<std::string>>);
+    static_assert(std::ranges::bidirectional_range<UnrolledSkipList<int>>);
+
+    UnrolledSkipList<int> sl;
+    std::set<int> reference;
+    std::mt19937 gen(17);
+    for (int i = 0; i < 20000; ++i) {
+        int key = static_cast<int>(gen() % 5000);
+        switch (gen() % 4) {
+        case 0:
+        case 1:
+            EXPECT_EQ(sl.insert(key).second, reference.insert(key).second);
+            break;
+        case 2:
+            EXPECT_EQ(sl.erase(key), reference.erase(key) > 0);
+            break;
+        default: {
+            auto it = sl.lower_bound(key);
+            auto ref = reference.lower_bound(key);
+            ASSERT_EQ(it == sl.end(), ref == reference.end());
+            if (ref != reference.end()) {
+                EXPECT_EQ(*it, *ref);
+            }
+            EXPECT_EQ(sl.contains(key), reference.count(key) > 0);
+            break;
+        }
+        }
+    }
+    EXPECT_TRUE(sl.validate());
+    EXPECT_EQ(sl.size(), reference.size());
+    EXPECT_TRUE(std::equal(sl.begin(), sl.end(), reference.begin(), reference.end()));
+    EXPECT_TRUE(std::equal(sl.rbegin(), sl.rend(), reference.rbegin(), reference.rend()));
+    EXPECT_LT(sl.block_count(), sl.size() / 4);
+
+    auto it = sl.upper_bound(2500);
+    EXPECT_EQ(*it, *reference.upper_bound(2500));
+    int next = *std::next(it);
+    EXPECT_EQ(*sl.erase(it), next);
+
+    UnrolledSkipList<int> copy(sl);
+    EXPECT_TRUE(copy.validate());
+    EXPECT_TRUE(std::equal(copy.begin(), copy.end(), sl.begin(), sl.end()));
+    UnrolledSkipList<int> odds;
+    for (int i = 1; i < 6000; i += 2) {
+        odds.insert(i);
+    }
+    size_t expected = set_union(SkipList<int>(sorted_unique, copy.begin(), copy.end()),
+                                SkipList<int>(sorted_unique, odds.begin(), odds.end())).size();
+    copy.merge(odds);
+    EXPECT_EQ(copy.size(), expected);
+    EXPECT_EQ(copy.size() + odds.size(), sl.size() + 3000);
+    EXPECT_TRUE(copy.validate());
+    EXPECT_TRUE(odds.validate());
+
+    copy.clear();
+    EXPECT_TRUE(copy.empty());
+    EXPECT_TRUE(copy.begin() == copy.end());
+    copy.insert(3);
+    EXPECT_TRUE(copy.contains(3));
+}
+
+// SIMD Tests
+// lhs + sign * rhs, wrapping around for integer keys instead of overflowing
+template <typename T>
+static T wrappingStep(T lhs, T rhs, int sign) {
+    if constexpr (std::is_integral_v<T>) {
+        using U = std::make_unsigned_t<T>;
+        return static_cast<T>(sign < 0 ? static_cast<U>(lhs) - static_cast<U>(rhs) : static_cast<U>(lhs) + static_cast<U>(rhs));
+    } else {
+        return sign < 0 ? lhs - rhs : lhs + rhs;
+    }
+}
+
+template <typename T>
+static void checkSimdCounts(std::mt19937& gen) {
+    std::vector<T> keys;
+    for (int i = 0; i < 40; ++i) {
+        T key = static_cast<T>(gen());
+        keys.push_back(wrappingStep(key, static_cast<T>(gen() % 2 ? gen() : 0), -1));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    for (size_t n = 0; n <= keys.size(); ++n) {
+        for (size_t probe = 0; probe < keys.size(); ++probe) {
+            for (T key : {keys[probe], wrappingStep(keys[probe], T(1), 1), wrappingStep(keys[probe], T(1), -1)}) {
+                size_t before = std::lower_bound(keys.begin(), keys.begin() + n, key) - keys.begin();
+                size_t after = keys.begin() + n - std::upper_bound(keys.begin(), keys.begin() + n, key);
+                EXPECT_EQ(skiplist_simd::count_before(keys.data(), n, key), before);
+                EXPECT_EQ(skiplist_simd::count_after(keys.data(), n, key), after);
+            }
+        }
+    }
+}
+
+TEST(SkipListSimdTest, KernelsMatchScalarSearch) {
+    std::mt19937 gen(23);
+    checkSimdCounts<std::int32_t>(gen);
+    checkSimdCounts<std::uint32_t>(gen);
+    checkSimdCounts<std::int64_t>(gen);
+    checkSimdCounts<std::uint64_t>(gen);
+    checkSimdCounts<float>(gen);
+    checkSimdCounts<double>(gen);
+
+    UnrolledSkipList<double> sl;
+    for (int i = 0; i < 1000; ++i) {
+        sl.insert(i * 0.5);
+    }
+    EXPECT_EQ(*sl.lower_bound(100.2), 100.5);
+    EXPECT_EQ(*sl.upper_bound(100.5), 101.0);
+    EXPECT_TRUE(sl.find(100.25) == sl.end());
+    EXPECT_TRUE(sl.validate());
+}
+
+// Map Tests
+TEST(SkipMapTest, MapInterface) {
+    SkipMap<std::string, int> map{{"b", 2}, {"a", 1}};
+    map["c"] = 3;
+    ++map["a"];
+    EXPECT_EQ(map.size(), 3u);
+    EXPECT_EQ(map.at("a"), 2);
+    EXPECT_THROW(map.at("z"), std::out_of_range);
+
+    // Heterogeneous lookups need no std::string, let alone a dummy pair
+    std::string_view view = "b";
+    EXPECT_EQ(map.find(view)->second, 2);
+    EXPECT_TRUE(map.contains("c"));
+    EXPECT_EQ(map.count(view), 1u);
+    EXPECT_EQ(map.lower_bound("bb")->first, "c");
+    EXPECT_EQ(map.erase(view), 1u);
+    EXPECT_EQ(map.erase("b"), 0u);
+
+    EXPECT_FALSE(map.insert({"a", 9}).second);
+    EXPECT_FALSE(map.insert_or_assign("a", 10).second);
+    EXPECT_EQ(map["a"], 10);
+    EXPECT_TRUE(map.emplace("d", 4).second);
+    EXPECT_FALSE(map.emplace("d", 5).second);
+    std::vector<std::pair<std::string, int>> entries(map.begin(), map.end());
+    EXPECT_EQ(entries, (std::vector<std::pair<std::string, int>>{{"a", 10}, {"c", 3}, {"d", 4}}));
+    EXPECT_TRUE(map.validate());
+
+    SkipMap<std::string, int> copy;
+    copy = map;
+    EXPECT_EQ(copy, map);
+    copy.clear();
+    copy["e"] = 5;
+    copy["a"] = 0;
+    map.merge(copy);
+    EXPECT_EQ(map.size(), 4u);
+    EXPECT_EQ(map["a"], 10);
+    ASSERT_EQ(copy.size(), 1u);
+    EXPECT_EQ(copy.begin()->first, "a");
+}
+
+TEST(SkipMapTest, TryEmplaceBuildsNothingForPresentKeys) {
+    SkipMap<std::string, Record> map;
+    Record::copies = 0;
+    Record::constructed = 0;
+    auto [it, inserted] = map.try_emplace("a", "a", "first");
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it->second.payload, "first");
+    auto [it2, inserted2] = map.try_emplace("a", "a", "second");
+    EXPECT_FALSE(inserted2);
+    EXPECT_EQ(it2, it);
+    EXPECT_EQ(it->second.payload, "first");
+
+    // An rvalue key is moved into the entry
+    std::string key(64, 'k');
+    map.try_emplace(std::move(key), "k", "moved");
+    EXPECT_TRUE(map.contains(std::string(64, 'k')));
+    map.insert_or_assign("a", Record("a", "assigned"));
+    EXPECT_EQ(map.at("a").payload, "assigned");
+    EXPECT_EQ(Record::copies, 0);
+    EXPECT_EQ(Record::constructed, 3);
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_TRUE(map.validate());
+}
+
+TEST(SkipMapTest, MatchesStdMap) {
+    SkipMap<int, int> map;
+    std::map<int, int> reference;
+    std::mt19937 gen(11);
+    for (int i = 0; i < 20000; ++i) {
+        int key = gen() % 2000;
+        switch (gen() % 4) {
+        case 0:
+            map[key] += i;
+            reference[key] += i;
+            break;
+        case 1:
+            EXPECT_EQ(map.insert_or_assign(key, i).second, reference.insert_or_assign(key, i).second);
+            break;
+        case 2:
+            EXPECT_EQ(map.erase(key), reference.erase(key));
+            break;
+        default:
+            EXPECT_EQ(map.try_emplace(key, i).second, reference.try_emplace(key, i).second);
+        }
+    }
+    EXPECT_TRUE(map.validate());
+    EXPECT_TRUE(std::ranges::equal(map, reference));
+}
+
+TEST(SkipMultiMapTest, EquivalentKeysKeepInsertionOrder) {
+    SkipMultiMap<int, std::string> multi;
+    std::multimap<int, std::string> reference;
+    std::mt19937 gen(5);
+    for (int i = 0; i < 5000; ++i) {
+        int key = gen() % 100;
+        if (gen() % 5 == 0) {
+            EXPECT_EQ(multi.erase(key), reference.erase(key));
+        } else {
+            multi.insert({key, std::to_string(i)});
+            reference.insert({key, std::to_string(i)});
+        }
+    }
+    EXPECT_TRUE(multi.validate());
+    EXPECT_TRUE(std::ranges::equal(multi, reference));
+    for (int key = 0; key < 100; ++key) {
+        EXPECT_EQ(multi.count(key), reference.count(key));
+        auto [first, last] = multi.equal_range(key);
+        auto [ref_first, ref_last] = reference.equal_range(key);
+        EXPECT_TRUE(std::equal(first, last, ref_first, ref_last));
+        EXPECT_EQ(multi.find(key) == multi.end(), reference.find(key) == reference.end());
+        if (first != last) {
+            EXPECT_EQ(multi.find(key), first);
+        }
+    }
+
+    // merge takes every entry, behind the equivalents already present
+    SkipMultiMap<int, std::string> other{{50, "x"}, {50, "y"}, {1000, "z"}};
+    size_t before = multi.count(50);
+    multi.merge(other);
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(multi.count(50), before + 2);
+    EXPECT_EQ(std::prev(multi.upper_bound(50))->second, "y");
+    EXPECT_EQ(multi.emplace(1000, "w")->second, "w");
+    EXPECT_EQ(std::prev(multi.end())->second, "w");
+    EXPECT_TRUE(multi.validate());
+}
+
+TEST(SkipMultiMapTest, EraseBetweenEquivalents) {
+    // Towers are erased by position, among runs of equivalent keys
+    using Entry = std::pair<const int, int>;
+    SkipList<Entry, SkipMapCompare<int, int, std::less<>, true>, std::allocator<Entry>, true> indexed;
+    SkipMultiMap<int, int> multi;
+    std::vector<std::pair<int, int>> reference;
+    auto same_entry = [](const Entry& entry, const std::pair<int, int>& expected) { return entry == Entry(expected); };
+    std::mt19937 gen(21);
+    for (int i = 0; i < 3000; ++i) {
+        if (reference.empty() || gen() % 3) {
+            int key = gen() % 20;
+            indexed.insert({key, i});
+            multi.insert({key, i});
+            auto pos = std::upper_bound(reference.begin(), reference.end(), key,
+                                        [](int k, const auto& entry) { return k < entry.first; });
+            reference.insert(pos, {key, i});
+        } else {
+            size_t index = gen() % reference.size();
+            indexed.erase(indexed.nth(index));
+            multi.erase(std::next(multi.begin(), index));
+            reference.erase(reference.begin() + index);
+        }
+    }
+    EXPECT_TRUE(indexed.validate());
+    EXPECT_TRUE(multi.validate());
+    EXPECT_TRUE(std::equal(indexed.begin(), indexed.end(), reference.begin(), reference.end(), same_entry));
+    EXPECT_TRUE(std::equal(multi.begin(), multi.end(), reference.begin(), reference.end(), same_entry));
+
+    auto first = std::next(multi.lower_bound(7));
+    auto last = std::prev(multi.upper_bound(9));
+    auto ref_first = reference.begin() + std::distance(multi.begin(), first);
+    auto ref_last = reference.begin() + std::distance(multi.begin(), last);
+    multi.erase(first, last);
+    reference.erase(ref_first, ref_last);
+    EXPECT_TRUE(multi.validate());
+    EXPECT_TRUE(std::equal(multi.begin(), multi.end(), reference.begin(), reference.end(), same_entry));
+}
+
+// Versioned Tests
+TEST(VersionedSkipListTest, SnapshotsSeeTheirVersion) {
+    VersionedSkipList<int> vsl;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(vsl.insert(i).second);
+    }
+    EXPECT_FALSE(vsl.insert(5).second);
+    EXPECT_EQ(vsl.version(), 100u);
+
+    auto first = vsl.snapshot();
+    for (int i = 0; i < 100; i += 2) {
+        EXPECT_TRUE(vsl.erase(i));
+    }
+    for (int i = 100; i < 150; ++i) {
+        vsl.insert(i);
+    }
+    vsl.insert(0);
+    auto second = vsl.snapshot();
+    EXPECT_TRUE(vsl.erase(0));
+    EXPECT_FALSE(vsl.erase(0));
+
+    std::vector<int> all(100);
+    std::iota(all.begin(), all.end(), 0);
+    EXPECT_TRUE(std::ranges::equal(first, all));
+    EXPECT_EQ(first.size(), 100u);
+    EXPECT_TRUE(first.contains(2));
+    EXPECT_FALSE(first.contains(100));
+    EXPECT_EQ(*first.lower_bound(99), 99);
+    EXPECT_EQ(first.upper_bound(99), first.end());
+    EXPECT_EQ(*std::prev(first.end()), 99);
+
+    std::vector<int> live;
+    for (int i = 1; i < 100; i += 2) live.push_back(i);
+    for (int i = 100; i < 150; ++i) live.push_back(i);
+    EXPECT_TRUE(std::ranges::equal(vsl, live));
+    EXPECT_EQ(vsl.size(), live.size());
+    live.insert(live.begin(), 0);
+    EXPECT_TRUE(std::ranges::equal(second, live));
+    EXPECT_EQ(second.size(), live.size());
+    EXPECT_EQ(*second.find(0), 0);
+    EXPECT_EQ(vsl.find(0), vsl.end());
+    EXPECT_EQ(*vsl.lower_bound(0), 1);
+
+    // Both versions of 0 and the erased even keys are kept for the snapshots
+    EXPECT_EQ(vsl.retained(), 51u);
+    EXPECT_TRUE(vsl.validate());
+    {
+        auto dropped = std::move(first);
+    }
+    EXPECT_EQ(vsl.retained(), 1u);
+    EXPECT_TRUE(vsl.validate());
+    second = vsl.snapshot();
+    EXPECT_EQ(vsl.retained(), 0u);
+    EXPECT_TRUE(vsl.validate());
+}
+
+TEST(VersionedSkipListTest, ReverseIterationAndReclaimOrder) {
+    VersionedSkipList<int> vsl;
+    for (int i = 10; i < 20; ++i) {
+        vsl.insert(i);
+    }
+    auto old = vsl.snapshot();
+    // Entries the snapshot cannot see sit before its first element
+    for (int i = 0; i < 10; ++i) {
+        vsl.insert(i);
+    }
+    vsl.erase(10);
+    std::vector<int> backwards;
+    for (auto it = old.end(); it != old.begin();) {
+        backwards.push_back(*--it);
+    }
+    EXPECT_TRUE(std::ranges::equal(backwards, std::views::iota(10, 20) | std::views::reverse));
+    auto first = old.begin();
+    EXPECT_EQ(*--first, 10);
+    auto current = vsl.begin();
+    EXPECT_EQ(*--current, 0);
+    EXPECT_EQ(*std::prev(vsl.find(11)), 9);
+
+    // Erases after a newer snapshot wait for the oldest one, then go in erase order
+    auto newer = vsl.snapshot();
+    vsl.erase(11);
+    vsl.erase(0);
+    EXPECT_EQ(vsl.retained(), 3u);
+    {
+        auto dropped = std::move(newer);
+    }
+    EXPECT_EQ(vsl.retained(), 3u);
+    EXPECT_TRUE(vsl.validate());
+    {
+        auto dropped = std::move(old);
+    }
+    EXPECT_EQ(vsl.retained(), 0u);
+    EXPECT_TRUE(vsl.validate());
+}
+
+TEST(VersionedSkipListTest, ScanWhileWriting) {
+    VersionedSkipList<std::string> vsl;
+    for (int i = 0; i < 1000; ++i) {
+        vsl.insert(std::to_string(i));
+    }
+    auto view = vsl.snapshot();
+    size_t seen = 0;
+    for (const std::string& key : view) {
+        // The element under the iterator goes away and new ones appear around it
+        EXPECT_TRUE(vsl.erase(key));
+        vsl.insert(key + "x");
+        ++seen;
+    }
+    EXPECT_EQ(seen, 1000u);
+    EXPECT_EQ(vsl.size(), 1000u);
+    EXPECT_EQ(vsl.retained(), 1000u);
+    EXPECT_TRUE(vsl.validate());
+}
+
+TEST(VersionedSkipListTest, MatchesCopiedSets) {
+    VersionedSkipList<int> vsl;
+    std::set<int> reference;
+    std::vector<std::pair<VersionedSkipList<int>::Snapshot, std::set<int>>> views;
+    std::mt19937 gen(17);
+    for (int i = 0; i < 20000; ++i) {
+        int key = gen() % 500;
+        switch (gen() % 16) {
+        case 0:
+            views.emplace_back(vsl.snapshot(), reference);
+            break;
+        case 1:
+            if (!views.empty()) {
+                views.erase(views.begin() + gen() % views.size());
+            }
+            break;
+        default:
+            if (gen() & 1) {
+                EXPECT_EQ(vsl.insert(key).second, reference.insert(key).second);
+            } else {
+                EXPECT_EQ(vsl.erase(key), reference.erase(key) == 1);
+            }
+        }
+    }
+    EXPECT_TRUE(vsl.validate());
+    EXPECT_TRUE(std::ranges::equal(vsl, reference));
+    for (const auto& [view, expected] : views) {
+        EXPECT_EQ(view.size(), expected.size());
+        EXPECT_TRUE(std::ranges::equal(view, expected));
+    }
+    views.clear();
+    EXPECT_EQ(vsl.retained(), 0u);
+    vsl.clear();
+    EXPECT_TRUE(vsl.empty());
+    EXPECT_TRUE(vsl.validate());
+}
+
+// Level Generator Tests
+TEST(SkipLevelGeneratorTest, PromotionProbability) {
+    for (double p : {SkipLevelGenerator::HALF, SkipLevelGenerator::QUARTER, SkipLevelGenerator::INV_E}) {
+        SkipLevelGenerator gen(p, 12345);
+        const int N = 100000;
+        int promoted = 0;
+        for (int i = 0; i < N; ++i) {
+            int level = gen(16);
+            EXPECT_GE(level, 1);
+            EXPECT_LE(level, 16);
+            if (level > 1) ++promoted;
+        }
+        EXPECT_NEAR(static_cast<double>(promoted) / N, p, 0.01);
+    }
+    EXPECT_THROW(SkipLevelGenerator(1.0), std::invalid_argument);
+}
+
+TEST(SkipLevelGeneratorTest, SeededListsAreReproducible) {
+    SkipList<int> a(SkipLevelGenerator(SkipLevelGenerator::QUARTER, 42));
+    SkipList<int> b(SkipLevelGenerator(SkipLevelGenerator::QUARTER, 42));
+    for (int i = 0; i < 500; ++i) {
+        a.insert(i);
+        b.insert(i);
+    }
+    testing::internal::CaptureStdout();
+    a.printAllLevels();
+    std::string levels_a = testing::internal::GetCapturedStdout();
+    testing::internal::CaptureStdout();
+    b.printAllLevels();
+    EXPECT_EQ(levels_a, testing::internal::GetCapturedStdout());
+    EXPECT_TRUE(a.validate());
+}
+
+// Stats Tests
+TEST(SkipListStatsTest, ShapeAndCounters) {
+    SkipList<int> sl(SkipLevelGenerator(SkipLevelGenerator::HALF, 3));
+    for (int i = 0; i < 1000; ++i) {
+        sl.insert(i);
+    }
+    SkipListStats built = sl.stats();
+    EXPECT_EQ(built.size, 1000u);
+    EXPECT_EQ(built.max_level, skiplist_default_max_level);
+    EXPECT_EQ(built.promotion_probability, SkipLevelGenerator::HALF);
+    ASSERT_EQ(built.level_histogram.size(), skiplist_default_max_level + 1u);
+    EXPECT_EQ(std::accumulate(built.level_histogram.begin(), built.level_histogram.end(), size_t{0}), 1000u);
+    EXPECT_GT(built.level_histogram[built.current_max_level], 0u);
+    EXPECT_GT(built.level_histogram[1], built.level_histogram[2]);
+#if SKIPLIST_STATS
+    EXPECT_EQ(built.nodes_allocated, 1002u);
+    EXPECT_EQ(built.bytes_in_use, built.bytes_allocated - built.bytes_freed);
+    EXPECT_GE(built.level_growths, 1u);
+    EXPECT_LT(static_cast<int>(built.level_growths), built.current_max_level);
+    EXPECT_EQ(built.searches, 1000u);
+#endif
+
+    sl.reset_stats();
+    for (int i = 0; i < 1000; i += 10) {
+        EXPECT_TRUE(sl.contains(i));
+    }
+#if SKIPLIST_STATS
+    SkipListStats lookups = sl.stats();
+    EXPECT_EQ(lookups.searches, 100u);
+    EXPECT_EQ(lookups.nodes_allocated, 0u);
+    EXPECT_GE(lookups.comparisons, lookups.search_steps + lookups.searches);
+    EXPECT_GT(lookups.average_path_length(), 1.0);
+    EXPECT_LT(lookups.comparisons_per_search(), 4.0 * built.current_max_level);
+#endif
+
+    sl.clear();
+    SkipListStats cleared = sl.stats();
+#if SKIPLIST_STATS
+    EXPECT_EQ(cleared.nodes_freed, 1000u);
+    EXPECT_EQ(cleared.bytes_freed, built.bytes_in_use - cleared.bytes_in_use);
+#endif
+    EXPECT_EQ(cleared.current_max_level, 1);
+
+    std::ostringstream json;
+    sl.printStats(json);
+    EXPECT_EQ(json.str().rfind("{\"size\":0,\"current_max_level\":1,", 0), 0u);
+    EXPECT_NE(json.str().find("\"level_histogram\":[0,0,"), std::string::npos);
+    EXPECT_EQ(json.str().back(), '\n');
+}
+
+TEST(SkipListStatsTest, LevelTrimsOnErase) {
+    SkipList<int> sl(SkipLevelGenerator(SkipLevelGenerator::QUARTER, 9));
+    for (int i = 0; i < 2000; ++i) {
+        sl.insert(i);
+    }
+    int levels = sl.stats().current_max_level;
+    sl.reset_stats();
+    for (int i = 0; i < 2000; ++i) {
+        sl.erase(i);
+    }
+    SkipListStats stats = sl.stats();
+    EXPECT_EQ(stats.size, 0u);
+    EXPECT_EQ(stats.current_max_level, 1);
+#if SKIPLIST_STATS
+    EXPECT_EQ(static_cast<int>(stats.level_trims), levels - 1);
+    EXPECT_EQ(stats.level_growths, 0u);
+    EXPECT_EQ(stats.nodes_freed, 2000u);
+#else
+    EXPECT_GT(levels, 1);
+#endif
+}
+
+TEST(SkipListStatsTest, RebalanceAfterChurn) {
+    // Balanced build, then erasing every odd key leaves only towers of height 1
+    for (bool indexable : {false, true}) {
+        SCOPED_TRACE(indexable);
+        auto check = [](auto& sl) {
+            std::vector<int> keys(4096);
+            std::iota(keys.begin(), keys.end(), 0);
+            sl.assign_sorted(keys.begin(), keys.end(), true);
+            EXPECT_FALSE(sl.needs_rebalance());
+            for (int i = 1; i < 4096; i += 2) {
+                sl.erase(i);
+            }
+            SkipListStats churned = sl.stats();
+            EXPECT_EQ(churned.current_max_level, 1);
+            EXPECT_GT(churned.expected_path_length, 500.0);
+            EXPECT_TRUE(sl.needs_rebalance());
+
+            EXPECT_TRUE(sl.rebalance_if_needed());
+            ASSERT_TRUE(sl.validate());
+            SkipListStats rebuilt = sl.stats();
+            EXPECT_EQ(rebuilt.size, 2048u);
+            EXPECT_EQ(rebuilt.level_histogram[1], 1024u);
+            EXPECT_EQ(rebuilt.level_histogram[2], 512u);
+            EXPECT_EQ(rebuilt.current_max_level, 12);
+            EXPECT_LT(rebuilt.expected_path_length, 11.0);
+            EXPECT_FALSE(sl.rebalance_if_needed());
+            for (int i = 0; i < 4096; ++i) {
+                EXPECT_EQ(sl.contains(i), i % 2 == 0);
+            }
+            EXPECT_EQ(*std::next(sl.begin(), 1000), 2000);
+        };
+        if (indexable) {
+            IndexableSkipList<int> sl;
+            check(sl);
+            EXPECT_EQ(*sl.nth(1000), 2000);
+            EXPECT_EQ(sl.rank(3001), 1501u);
+        } else {
+            SkipList<int> sl;
+            check(sl);
+        }
+    }
+
+    SkipList<std::string> strings;
+    for (int i = 0; i < 300; ++i) {
+        strings.insert(std::string(40, 'a') + std::to_string(i));
+    }
+    SkipList<std::string> copy = strings;
+    strings.rebalance();
+    EXPECT_TRUE(strings.validate());
+    EXPECT_TRUE(strings == copy);
+    EXPECT_EQ(strings.stats().level_histogram[1], 150u);
+
+    // Random heights are what the cost model calls normal, whatever p
+    SkipList<int> quarter(SkipLevelGenerator(SkipLevelGenerator::QUARTER, 13));
+    for (int i = 0; i < 10000; ++i) {
+        quarter.insert((i * 7919) % 10000);
+    }
+    EXPECT_FALSE(quarter.needs_rebalance());
+}
+
+TEST(SkipListStatsTest, SearchPathMatchesDescent) {
+    SkipList<int> sl(SkipLevelGenerator(SkipLevelGenerator::HALF, 5));
+    for (int i = 0; i < 500; i += 2) {
+        sl.insert(i);
+    }
+    for (int key = -1; key <= 500; ++key) {
+        auto path = sl.search_path(key);
+        ASSERT_EQ(path.size(), static_cast<size_t>(sl.stats().current_max_level));
+        size_t steps = 0;
+        const int* predecessor = nullptr;
+        for (size_t i = 0; i < path.size(); ++i) {
+            EXPECT_EQ(path[i].level, static_cast<int>(path.size() - i));
+            if (predecessor) {
+                ASSERT_NE(path[i].predecessor, nullptr);
+                EXPECT_GE(*path[i].predecessor, *predecessor);
+            }
+            predecessor = path[i].predecessor;
+            if (predecessor) {
+                EXPECT_LT(*predecessor, key);
+            }
+            if (path[i].next) {
+                EXPECT_GE(*path[i].next, key);
+            }
+            steps += path[i].steps;
+        }
+        auto it = sl.lower_bound(key);
+        EXPECT_EQ(path.back().next, it == sl.end() ? nullptr : &*it);
+        EXPECT_EQ(path.back().predecessor, it == sl.begin() ? nullptr : &*std::prev(it));
+
+#if SKIPLIST_STATS
+        sl.reset_stats();
+        sl.lower_bound(key);
+        EXPECT_EQ(sl.stats().search_steps, steps);
+#else
+        (void)steps;
+#endif
+    }
+}
+
+// Arena Allocator Tests
+TEST(SkipListArenaTest, InsertEraseReuse) {
+    SkipList<std::string, std::less<>, SkipListArenaAllocator<std::string>> sl;
+    for (int i = 0; i < 1000; ++i) {
+        sl.insert("key" + std::to_string(i));
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        EXPECT_TRUE(sl.erase("key" + std::to_string(i)));
+    }
+    EXPECT_EQ(sl.size(), 500);
+    EXPECT_TRUE(sl.validate());
+
+    size_t reserved = sl.get_allocator().resource().reserved();
+    sl.clear();
+    for (int i = 0; i < 1000; ++i) {
+        sl.insert("key" + std::to_string(i));
+    }
+    EXPECT_EQ(sl.get_allocator().resource().reserved(), reserved);
+    EXPECT_TRUE(sl.validate());
+}
+
+TEST(SkipListArenaTest, CopyAndMove) {
+    using ArenaList = SkipList<int, std::less<>, SkipListArenaAllocator<int>>;
+    ArenaList sl;
+    for (int i = 0; i < 100; ++i) {
+        sl.insert(i);
+    }
+    ArenaList copy(sl);
+    EXPECT_FALSE(copy.get_allocator() == sl.get_allocator());
+    EXPECT_TRUE(copy == sl);
+
+    ArenaList moved(std::move(sl));
+    EXPECT_TRUE(moved == copy);
+    EXPECT_TRUE(sl.empty());
+    sl = std::move(copy);
+    EXPECT_EQ(sl.size(), 100);
+    EXPECT_TRUE(sl.validate());
+}
+
+TEST(SkipListArenaTest, DroppedSharersReturnTowers) {
+    using ArenaList = SkipList<std::string, std::less<>, SkipListArenaAllocator<std::string>>;
+    ArenaList sl;
+    size_t reserved = 0;
+    for (int round = 0; round < 50; ++round) {
+        for (int i = 0; i < 1000; ++i) {
+            sl.insert(std::to_string(100000 + i));
+        }
+        // The upper half shares the arena; dropping it must recycle its towers
+        {
+            ArenaList upper = sl.split(std::string("100000"));
+            EXPECT_EQ(upper.size(), 1000);
+        }
+        EXPECT_TRUE(sl.empty());
+        if (round == 0) {
+            reserved = sl.get_allocator().resource().reserved();
+        }
+    }
+    EXPECT_EQ(sl.get_allocator().resource().reserved(), reserved);
+}
+
+TEST(SkipListParallelTest, SortedBuild) {
+    std::vector<int> nums(100000);
+    std::iota(nums.begin(), nums.end(), -50000);
+    IndexableSkipList<int> built;
+    built.insert(7);
+    built.reset_stats();
+    built.assign_sorted(parallel_t{8}, nums.begin(), nums.end());
+    EXPECT_EQ(built.size(), nums.size());
+    EXPECT_TRUE(built.validate());
+    EXPECT_TRUE(std::ranges::equal(built, nums));
+    for (size_t k : {0, 4095, 4096, 12345, 99999}) {
+        EXPECT_EQ(*built.nth(k), nums[k]);
+    }
+#if SKIPLIST_STATS
+    EXPECT_EQ(built.stats().nodes_allocated, nums.size());
+    EXPECT_EQ(built.stats().nodes_freed, 1);
+#endif
+
+    // Balanced heights do not depend on the split
+    SkipList<int> serial;
+    SkipList<int> parallel_built;
+    serial.assign_sorted(nums.begin(), nums.end(), true);
+    parallel_built.assign_sorted(parallel, nums.begin(), nums.end(), true);
+    EXPECT_EQ(parallel_built.stats().level_histogram, serial.stats().level_histogram);
+    EXPECT_TRUE(parallel_built == serial);
+    EXPECT_TRUE(parallel_built.validate());
+
+    // Small inputs and stateful allocators build serially
+    parallel_built.assign_sorted(parallel_t{8}, nums.begin(), nums.begin() + 10);
+    EXPECT_EQ(parallel_built.size(), 10);
+    SkipList<int, std::less<>, SkipListArenaAllocator<int>> arena;
+    arena.assign_sorted(parallel_t{8}, nums.begin(), nums.end());
+    EXPECT_TRUE(std::ranges::equal(arena, nums));
+}
+
+TEST(SkipListParallelTest, ForEachAndSetAlgebra) {
+    std::mt19937 gen(25);
+    SkipList<int> lhs;
+    SkipList<int> rhs;
+    for (int i = 0; i < 60000; ++i) {
+        lhs.insert(static_cast<int>(gen() % 200000));
+        rhs.insert(static_cast<int>(gen() % 100000));
+    }
+    std::atomic<long long> sum{0};
+    std::as_const(lhs).for_each(parallel_t{8}, [&](int v) { sum += v; });
+    EXPECT_EQ(sum.load(), std::accumulate(lhs.begin(), lhs.end(), 0LL));
+
+    SkipList<int> doubled(lhs);
+    doubled.for_each(parallel_t{8}, [](int& v) { v *= 2; });
+    EXPECT_TRUE(doubled.validate());
+    EXPECT_EQ(*std::prev(doubled.end()), 2 * *std::prev(lhs.end()));
+
+    const int first = *lhs.begin();
+    EXPECT_THROW(lhs.for_each(parallel_t{4}, [first](int v) { if (v == first) throw std::runtime_error("stop"); }),
+                 std::runtime_error);
+
+    auto check = [](const SkipList<int>& parallel_result, const SkipList<int>& serial_result) {
+        EXPECT_TRUE(parallel_result == serial_result);
+        EXPECT_TRUE(parallel_result.validate());
+    };
+    check(set_union(parallel_t{8}, lhs, rhs), set_union(lhs, rhs));
+    check(set_intersection(parallel_t{8}, lhs, rhs), set_intersection(lhs, rhs));
+    check(set_difference(parallel_t{8}, lhs, rhs), set_difference(lhs, rhs));
+    check(set_difference(parallel_t{8}, rhs, lhs), set_difference(rhs, lhs));
+    check(set_symmetric_difference(parallel_t{8}, lhs, rhs), set_symmetric_difference(lhs, rhs));
+    check(set_union(parallel_t{8}, lhs, SkipList<int>()), lhs);
+}
+
+TEST(SkipListMmapTest, ReopenAdoptsSavedList) {
+    using MmapList = SkipList<int, std::less<>, MmapAllocator<int>>;
+    const std::string path = testing::TempDir() + "skiplist_mmap_" + std::to_string(::getpid()) + ".skl";
+    std::remove(path.c_str());
+    std::set<int> reference;
+    std::mt19937 gen(22);
+    int levels = 0;
+    {
+        auto file = SkipListMmapFile::open(path, std::size_t{1} << 24);
+        MmapList sl{std::less<>(), MmapAllocator<int>(file)};
+        for (int i = 0; i < 5000; ++i) {
+            int value = static_cast<int>(gen() % 20000);
+            sl.insert(value);
+            reference.insert(value);
+        }
+        // A second list on the same file while the first is open is transient
+        MmapList scratch{std::less<>(), MmapAllocator<int>(file)};
+        scratch.insert(-1);
+        EXPECT_EQ(scratch.size(), 1);
+        EXPECT_THROW(SkipListMmapFile::open(path), std::runtime_error);
+        levels = sl.stats().current_max_level;
+    }
+    {
+        auto file = SkipListMmapFile::open(path);
+        MmapList sl{std::less<>(), MmapAllocator<int>(file)};
+        EXPECT_EQ(sl.size(), reference.size());
+        EXPECT_EQ(sl.stats().current_max_level, levels);
+        EXPECT_TRUE(sl.validate());
+        EXPECT_TRUE(std::ranges::equal(sl, reference));
+        for (int i = 0; i < 2000; ++i) {
+            int value = static_cast<int>(gen() % 20000);
+            if (i % 2) {
+                EXPECT_EQ(sl.erase(value), reference.erase(value));
+            } else {
+                sl.insert(value);
+                reference.insert(value);
+            }
+        }
+        // Freed towers are handed out again
+        std::size_t used = file->used();
+        sl.erase(*sl.begin());
+        reference.erase(reference.begin());
+        sl.insert(-5);
+        reference.insert(-5);
+        EXPECT_LE(file->used(), used + 2 * SkipListMmapFile::GRANULE * 8);
+    }
+    {
+        auto file = SkipListMmapFile::open(path);
+        MmapList sl{std::less<>(), MmapAllocator<int>(file)};
+        EXPECT_TRUE(sl.validate());
+        EXPECT_TRUE(std::ranges::equal(sl, reference));
+    }
+    std::remove(path.c_str());
+}
+
+TEST(SkipListMmapTest, SurvivesRemapAndCrash) {
+    using MmapList = SkipList<int, std::less<>, MmapAllocator<int>>;
+    const std::string path = testing::TempDir() + "skiplist_remap_" + std::to_string(::getpid()) + ".skl";
+    std::remove(path.c_str());
+    std::set<int> reference;
+    const void* saved = nullptr;
+    {
+        auto file = SkipListMmapFile::open(path, std::size_t{1} << 22);
+        MmapList sl{std::less<>(), MmapAllocator<int>(file)};
+        for (int i = 0; i < 3000; ++i) {
+            sl.insert(i * 7 % 3001);
+            reference.insert(i * 7 % 3001);
+        }
+        saved = file->address();
+    }
+    // Something else now lives at the saved address
+    void* blocker = ::mmap(const_cast<void*>(saved), 4096, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    ASSERT_EQ(blocker, saved);
+    {
+        auto file = SkipListMmapFile::open(path);
+        EXPECT_NE(file->address(), saved);
+        MmapList sl{std::less<>(), MmapAllocator<int>(file)};
+        EXPECT_TRUE(sl.validate());
+        EXPECT_TRUE(std::ranges::equal(sl, reference));
+        sl.insert(-1);
+        reference.insert(-1);
+    }
+    ::munmap(blocker, 4096);
+
+    // A process dying with the list open leaves it to be recovered, not rejected
+    pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        auto file = SkipListMmapFile::open(path);
+        MmapList sl{std::less<>(), MmapAllocator<int>(file)};
+        for (int i = 0; i < 500; ++i) {
+            sl.erase(i);
+            sl.insert(5000 + i);
+        }
+        ::_exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    for (int i = 0; i < 500; ++i) {
+        reference.erase(i);
+        reference.insert(5000 + i);
+    }
+    {
+        auto file = SkipListMmapFile::open(path);
+        MmapList sl{std::less<>(), MmapAllocator<int>(file)};
+        EXPECT_EQ(sl.size(), reference.size());
+        EXPECT_TRUE(sl.validate());
+        EXPECT_TRUE(std::ranges::equal(sl, reference));
+    }
+    std::remove(path.c_str());
+}
+
+TEST(SkipListMmapTest, RejectsForeignFiles) {
+    const std::string path = testing::TempDir() + "skiplist_foreign_" + std::to_string(::getpid()) + ".skl";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << std::string(8192, 'x');
+    }
+    EXPECT_THROW(SkipListMmapFile::open(path), std::runtime_error);
+    std::remove(path.c_str());
+
+    using WideList = SkipList<long long, std::less<>, MmapAllocator<long long>>;
+    using NarrowList = SkipList<int, std::less<>, MmapAllocator<int>>;
+    {
+        auto file = SkipListMmapFile::open(path, std::size_t{1} << 20);
+        WideList sl{std::less<>(), MmapAllocator<long long>(file)};
+        sl.insert(1);
+    }
+    {
+        auto file = SkipListMmapFile::open(path);
+        EXPECT_THROW((NarrowList{std::less<>(), MmapAllocator<int>(file)}), std::invalid_argument);
+    }
+    std::remove(path.c_str());
+}
+
+
+TEST(ConcurrentSkipListTest, SingleThreadedApi) {
+    ConcurrentSkipList<int> csl;
+    EXPECT_TRUE(csl.empty());
+    EXPECT_TRUE(csl.insert(20).second);
+    EXPECT_TRUE(csl.insert(10).second);
+    EXPECT_TRUE(csl.emplace(30).second);
+    auto [it, inserted] = csl.insert(20);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(*it, 20);
+
+    EXPECT_EQ(csl.size(), 3);
+    EXPECT_TRUE(csl.contains(10));
+    EXPECT_EQ(*csl.lower_bound(15), 20);
+    EXPECT_EQ(*csl.upper_bound(20), 30);
+    EXPECT_TRUE(csl.find(25) == csl.end());
+    EXPECT_TRUE(csl.erase(20));
+    EXPECT_FALSE(csl.erase(20));
+
+    std::vector<int> values(csl.begin(), csl.end());
+    EXPECT_EQ(values, (std::vector<int>{10, 30}));
+    EXPECT_TRUE(csl.validate());
+}
+
+TEST(ConcurrentSkipListTest, ParallelInserts) {
+    ConcurrentSkipList<int> csl;
+    const int threads = 4, per_thread = 2000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&csl, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                csl.insert(i * threads + t);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    EXPECT_EQ(csl.size(), threads * per_thread);
+    EXPECT_TRUE(csl.validate());
+    int expected = 0;
+    for (int value : csl) {
+        EXPECT_EQ(value, expected++);
+    }
+}
+
+TEST(ConcurrentSkipListTest, MixedInsertEraseWithReaders) {
+    ConcurrentSkipList<std::string> csl;
+    const int threads = 4, ops = 5000, keys = 200;
+    std::atomic<long> balance{0};
+    std::atomic<bool> done{false};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::mt19937 gen(t);
+            long local = 0;
+            for (int i = 0; i < ops; ++i) {
+                std::string key = std::to_string(gen() % keys);
+                if (gen() & 1) {
+                    local += csl.insert(key).second;
+                } else {
+                    local -= csl.erase(key);
+                }
+            }
+            balance += local;
+        });
+    }
+    std::thread reader([&] {
+        while (!done) {
+            std::string prev;
+            for (const std::string& key : csl) {
+                EXPECT_LT(prev, key);
+                prev = key;
+            }
+        }
+    });
+    // empty() reads the first tower while the workers retire it
+    std::thread prober([&] {
+        while (!done) {
+            csl.empty();
+        }
+    });
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    done = true;
+    reader.join();
+    prober.join();
+    EXPECT_EQ(static_cast<long>(csl.size()), balance.load());
+    EXPECT_EQ(csl.empty(), csl.size() == 0);
+    EXPECT_TRUE(csl.validate());
+}
+
+TEST(ShardedSkipListTest, SingleThreadedApi) {
+    ShardedSkipList<int> sharded(std::vector<int>{100, 200});
+    std::set<int> reference;
+    std::mt19937 gen(26);
+    for (int i = 0; i < 2000; ++i) {
+        int value = static_cast<int>(gen() % 300);
+        EXPECT_EQ(sharded.insert(value).second, reference.insert(value).second);
+        if (i % 3 == 0) {
+            int victim = static_cast<int>(gen() % 300);
+            EXPECT_EQ(sharded.erase(victim), reference.erase(victim) == 1);
+        }
+    }
+    EXPECT_EQ(sharded.size(), reference.size());
+    EXPECT_EQ(sharded.shard_count(), 3);
+    EXPECT_TRUE(std::ranges::equal(sharded, reference));
+    EXPECT_TRUE(sharded.validate());
+    // Bounds continue across shards
+    for (int key : {-1, 0, 99, 100, 150, 199, 200, 299, 300}) {
+        auto lower = sharded.lower_bound(key);
+        auto expected = reference.lower_bound(key);
+        ASSERT_EQ(lower == sharded.end(), expected == reference.end());
+        if (expected != reference.end()) {
+            EXPECT_EQ(*lower, *expected);
+        }
+        EXPECT_EQ(sharded.contains(key), reference.count(key) == 1);
+        EXPECT_EQ(sharded.find(key) != sharded.end(), reference.count(key) == 1);
+        // Advancing from a lookup fetches runs across the following shards
+        EXPECT_TRUE(std::ranges::equal(std::ranges::subrange(lower, sharded.end()),
+                                       std::ranges::subrange(expected, reference.end())));
+    }
+    auto it = sharded.insert(1000).first;
+    EXPECT_EQ(*it, 1000);
+    EXPECT_EQ(sharded.find(1000), it);
+    EXPECT_EQ(sharded.erase(it), sharded.end());
+    EXPECT_THROW(ShardedSkipList<int>(std::vector<int>{5, 5}), std::invalid_argument);
+}
+
+TEST(ShardedSkipListTest, SplitMergeRebalance) {
+    ShardedSkipList<int> sharded;
+    for (int i = 0; i < 10000; ++i) {
+        sharded.insert(i);
+    }
+    sharded.split_shard(2500);
+    sharded.split_shard(2500);
+    EXPECT_EQ(sharded.boundaries(), std::vector<int>{2500});
+    EXPECT_EQ(sharded.shard_sizes(), (std::vector<size_t>{2500, 7500}));
+    sharded.merge_shards(0);
+    EXPECT_EQ(sharded.shard_count(), 1);
+    EXPECT_THROW(sharded.merge_shards(0), std::out_of_range);
+
+    sharded.rebalance(8);
+    EXPECT_EQ(sharded.shard_count(), 8);
+    for (size_t shard_size : sharded.shard_sizes()) {
+        EXPECT_EQ(shard_size, 1250);
+    }
+    EXPECT_TRUE(sharded.validate());
+    sharded.rebalance(3);
+    EXPECT_EQ(sharded.shard_count(), 3);
+    EXPECT_EQ(sharded.size(), 10000);
+    EXPECT_TRUE(std::ranges::equal(sharded, std::views::iota(0, 10000)));
+    EXPECT_TRUE(sharded.validate());
+}
+
+TEST(ShardedSkipListTest, ConcurrentPointReadsOfOneShard) {
+    ShardedSkipList<int> sharded(std::vector<int>{1000});
+    for (int i = 0; i < 1000; i += 2) {
+        sharded.insert(i);
+    }
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, t] {
+            std::mt19937 gen(t);
+            for (int i = 0; i < 20000; ++i) {
+                int key = static_cast<int>(gen() % 998);
+                EXPECT_EQ(sharded.contains(key), key % 2 == 0);
+                auto it = sharded.find(key);
+                EXPECT_EQ(it != sharded.end(), key % 2 == 0);
+                auto lower = sharded.lower_bound(key | 1);
+                ASSERT_NE(lower, sharded.end());
+                EXPECT_EQ(*lower, (key | 1) + 1);
+            }
+        });
+    }
+    // A writer on the other shard does not disturb them
+    for (int i = 1000; i < 3000; ++i) {
+        sharded.insert(i);
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_TRUE(sharded.validate());
+}
+
+TEST(ShardedSkipListTest, WritersReadersAndRebalancing) {
+    ShardedSkipList<int> sharded(std::vector<int>{250, 500, 750});
+    const int threads = 4, ops = 5000, keys = 1000;
+    std::atomic<long> balance{0};
+    std::atomic<bool> done{false};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::mt19937 gen(t);
+            long local = 0;
+            for (int i = 0; i < ops; ++i) {
+                int key = static_cast<int>(gen() % keys);
+                if (gen() & 1) {
+                    local += sharded.insert(key).second;
+                } else {
+                    local -= sharded.erase(key);
+                }
+            }
+            balance += local;
+        });
+    }
+    std::thread reader([&] {
+        while (!done) {
+            int prev = -1;
+            for (int key : sharded) {
+                EXPECT_LT(prev, key);
+                prev = key;
+            }
+        }
+    });
+    std::thread balancer([&] {
+        for (size_t shards = 2; !done; shards = shards % 6 + 2) {
+            sharded.rebalance(shards);
+        }
+    });
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    done = true;
+    reader.join();
+    balancer.join();
+    EXPECT_EQ(static_cast<long>(sharded.size()), balance.load());
+    EXPECT_TRUE(sharded.validate());
+}
+
+TEST(SingleWriterSkipListTest, SingleThreadedApi) {
+    SingleWriterSkipList<int> swsl;
+    std::set<int> reference;
+    std::mt19937 gen(27);
+    for (int i = 0; i < 3000; ++i) {
+        int value = static_cast<int>(gen() % 500);
+        EXPECT_EQ(swsl.insert(value).second, reference.insert(value).second);
+        if (i % 2 == 0) {
+            int victim = static_cast<int>(gen() % 500);
+            EXPECT_EQ(swsl.erase(victim), reference.erase(victim) == 1);
+        }
+    }
+    EXPECT_EQ(swsl.size(), reference.size());
+    EXPECT_TRUE(std::ranges::equal(swsl, reference));
+    EXPECT_TRUE(swsl.validate());
+    for (int key : {-1, 0, 10, 250, 499, 500}) {
+        auto lower = swsl.lower_bound(key);
+        auto expected = reference.lower_bound(key);
+        ASSERT_EQ(lower == swsl.end(), expected == reference.end());
+        if (expected != reference.end()) {
+            EXPECT_EQ(*lower, *expected);
+        }
+        auto upper = swsl.upper_bound(key);
+        auto expected_upper = reference.upper_bound(key);
+        ASSERT_EQ(upper == swsl.end(), expected_upper == reference.end());
+        if (expected_upper != reference.end()) {
+            EXPECT_EQ(*upper, *expected_upper);
+        }
+        EXPECT_EQ(swsl.contains(key), reference.count(key) == 1);
+        EXPECT_EQ(swsl.find(key) != swsl.end(), reference.count(key) == 1);
+    }
+    auto [it, inserted] = swsl.emplace(1000);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*it, 1000);
+    EXPECT_EQ(swsl.read_retries(), 0);
+    swsl.clear();
+    EXPECT_TRUE(swsl.empty());
+    EXPECT_EQ(swsl.size(), 0);
+    EXPECT_TRUE(swsl.validate());
+}
+
+TEST(SingleWriterSkipListTest, OneWriterManyReaders) {
+    SingleWriterSkipList<std::string> swsl;
+    const int keys = 400, ops = 20000, readers = 3;
+    // Odd keys stay in the list; the writer churns the even ones
+    for (int i = 1; i < keys; i += 2) {
+        swsl.insert(std::to_string(i));
+    }
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+            std::mt19937 gen(r);
+            while (!done) {
+                int key = static_cast<int>(gen() % keys) | 1;
+                EXPECT_TRUE(swsl.contains(std::to_string(key)));
+                std::string prev;
+                int stable = 0;
+                for (const std::string& value : swsl) {
+                    EXPECT_LT(prev, value);
+                    stable += std::stoi(value) & 1;
+                    prev = value;
+                }
+                EXPECT_EQ(stable, keys / 2);
+            }
+        });
+    }
+    std::set<std::string> expected;
+    std::mt19937 gen(99);
+    for (int i = 0; i < ops; ++i) {
+        std::string key = std::to_string(static_cast<int>(gen() % keys) & ~1);
+        if (gen() & 1) {
+            EXPECT_EQ(swsl.insert(key).second, expected.insert(key).second);
+        } else {
+            EXPECT_EQ(swsl.erase(key), expected.erase(key) == 1);
+        }
+    }
+    done = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(swsl.size(), expected.size() + keys / 2);
+    EXPECT_TRUE(swsl.validate());
+}
+
+TEST(SkipListMaxLevelTest, TemplateCap) {
+    static_assert(SkipList<int>::max_level() == skiplist_default_max_level);
+    static_assert(skiplist_levels_for(300) == 9);
+    static_assert(skiplist_levels_for(1) == 2);
+    SkipList<int, std::less<>, std::allocator<int>, false, 4> capped;
+    for (int i = 0; i < 5000; ++i) {
+        capped.insert(i);
+    }
+    EXPECT_LE(capped.stats().current_max_level, 4);
+    EXPECT_EQ(capped.stats().max_level, 4);
+    EXPECT_TRUE(capped.validate());
+    EXPECT_GT(capped.max_size(), size_t{1} << 20);
+    IndexableSkipList<int, std::less<>, std::allocator<int>, 6> indexed;
+    indexed.insert(std::views::iota(0, 1000).begin(), std::views::iota(0, 1000).end());
+    EXPECT_EQ(*indexed.nth(500), 500);
+    EXPECT_TRUE(indexed.validate());
+}
+
+TEST(StaticSkipListTest, FixedCapacity) {
+    StaticSkipList<int, 300> queue;
+    static_assert(StaticSkipList<int, 300>::max_level() == 9);
+    EXPECT_EQ(queue.capacity(), 300);
+    std::set<int> reference;
+    std::mt19937 gen(28);
+    while (!queue.full()) {
+        int value = static_cast<int>(gen() % 1000);
+        EXPECT_EQ(queue.insert(value).second, reference.insert(value).second);
+    }
+    EXPECT_THROW(queue.insert(1000), std::bad_alloc);
+    EXPECT_FALSE(queue.contains(1000));
+    EXPECT_TRUE(queue.validate());
+    // Freed slots are reused
+    for (int i = 0; i < 1000; ++i) {
+        int victim = *std::next(reference.begin(), static_cast<long>(gen() % reference.size()));
+        EXPECT_TRUE(queue.erase(victim));
+        reference.erase(victim);
+        int value = static_cast<int>(gen() % 1000);
+        EXPECT_EQ(queue.insert(value).second, reference.insert(value).second);
+    }
+    EXPECT_TRUE(std::ranges::equal(queue, reference));
+    EXPECT_EQ(*queue.lower_bound(500), *reference.lower_bound(500));
+
+    StaticSkipList<int, 300> copy(queue);
+    EXPECT_TRUE(copy == queue);
+    StaticSkipList<int, 300> moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_TRUE(moved == queue);
+    moved.clear();
+    moved.insert(7);
+    queue = moved;
+    EXPECT_EQ(queue.size(), 1);
+    EXPECT_TRUE(queue.validate());
+
+    StaticSkipList<std::string, 8> names;
+    for (std::string name : {"d", "b", "a", "c"}) {
+        names.emplace(name);
+    }
+    EXPECT_EQ(names.range(std::string("b"), std::string("d")).front(), "b");
+    EXPECT_EQ(std::ranges::distance(names.range(std::string("b"), std::string("d"))), 2);
+
+    // A full list finds present keys before it needs a slot
+    StaticSkipList<int, 8> small;
+    for (int i = 0; i < 8; ++i) {
+        small.emplace(i * 10);
+    }
+    ASSERT_TRUE(small.full());
+    auto existing = small.end();
+    EXPECT_NO_THROW(existing = small.emplace(30));
+    ASSERT_NE(existing, small.end());
+    EXPECT_EQ(*existing, 30);
+    EXPECT_FALSE(small.insert(30).second);
+    EXPECT_FALSE(small.try_emplace(30).second);
+    EXPECT_THROW(small.emplace(35), std::bad_alloc);
+    EXPECT_EQ(small.size(), 8);
+    EXPECT_TRUE(small.validate());
+}
+
+template <typename List>
+static void checkStringSkipList() {
+    List urls;
+    std::set<std::string> reference;
+    std::mt19937 gen(29);
+    auto random_url = [&gen] {
+        std::string url = "https://www.example.com/catalog/";
+        for (int depth = static_cast<int>(gen() % 4); depth >= 0; --depth) {
+            url += "section" + std::to_string(gen() % 6) + "/";
+        }
+        return url + std::to_string(gen() % 50);
+    };
+    for (int i = 0; i < 4000; ++i) {
+        std::string url = random_url();
+        auto [it, inserted] = urls.insert(url);
+        EXPECT_EQ(inserted, reference.insert(url).second);
+        EXPECT_EQ(*it, url);
+        if (i % 3 == 0) {
+            std::string victim = random_url();
+            EXPECT_EQ(urls.erase(victim), reference.erase(victim) == 1);
+        }
+    }
+    EXPECT_TRUE(urls.insert("").second);
+    EXPECT_TRUE(urls.insert("https").second);
+    reference.insert("");
+    reference.insert("https");
+    EXPECT_EQ(urls.size(), reference.size());
+    EXPECT_TRUE(std::ranges::equal(urls, reference));
+    EXPECT_TRUE(urls.validate());
+    for (const std::string& probe : {std::string("https://www.example.com/catalog/section3/"), std::string("a"),
+                                     std::string("https://www.example.com/catalog/7"), std::string("~")}) {
+        auto lower = reference.lower_bound(probe);
+        EXPECT_EQ(urls.lower_bound(probe) == urls.end(), lower == reference.end());
+        if (lower != reference.end()) {
+            EXPECT_EQ(*urls.lower_bound(probe), *lower);
+        }
+        auto upper = reference.upper_bound(probe);
+        EXPECT_EQ(urls.upper_bound(probe) == urls.end(), upper == reference.end());
+        EXPECT_EQ(urls.contains(probe), reference.count(probe) == 1);
+    }
+    EXPECT_EQ(urls.find(*reference.begin()), urls.begin());
+    EXPECT_EQ(urls.key_bytes(), std::accumulate(reference.begin(), reference.end(), size_t{0},
+                                                [](size_t sum, const std::string& url) { return sum + url.size(); }));
+
+    List copy(urls);
+    EXPECT_TRUE(std::ranges::equal(copy, reference));
+    EXPECT_TRUE(copy.validate());
+    std::vector<std::string> sorted(reference.begin(), reference.end());
+    List built(sorted_unique, sorted.begin(), sorted.end());
+    EXPECT_TRUE(std::ranges::equal(built, reference));
+    EXPECT_TRUE(built.validate());
+    EXPECT_THROW(built.assign_sorted(sorted.rbegin(), sorted.rend()), std::invalid_argument);
+
+    // Keys ending inside, at and past the inline windows, with embedded zero bytes
+    List tricky;
+    std::set<std::string> expected;
+    for (int i = 0; i < 3000; ++i) {
+        std::string key(gen() % 3 == 0 ? 260 + gen() % 30 : gen() % 20, 'a');
+        for (char& c : key) {
+            c = "\0ab"[gen() % 3];
+        }
+        EXPECT_EQ(tricky.insert(key).second, expected.insert(key).second);
+        std::string probe = key.substr(0, gen() % (key.size() + 1));
+        EXPECT_EQ(tricky.contains(probe), expected.count(probe) == 1);
+        if (i % 2 == 0) {
+            EXPECT_EQ(tricky.erase(probe), expected.erase(probe) == 1);
+        }
+    }
+    EXPECT_TRUE(std::ranges::equal(tricky, expected));
+    EXPECT_TRUE(tricky.validate());
+}
+
+TEST(StringSkipListTest, MatchesStdSet) {
+    checkStringSkipList<StringSkipList<>>();
+    checkStringSkipList<StringSkipList<std::allocator<char>, true>>();
+}
+
+TEST(StringSkipListTest, SearchesSkipSharedPrefixes) {
+    StringSkipList<std::allocator<char>, true> urls;
+    for (int i = 0; i < 20000; ++i) {
+        urls.insert("https://www.example.com/item/" + std::to_string(i * 7919 % 20000));
+    }
+    urls.reset_stats();
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(urls.contains("https://www.example.com/item/" + std::to_string(i)));
+    }
+    StringSkipListStats stats = urls.stats();
+    // Every lookup reads the shared 29 bytes once at most, then compares a few digits
+    EXPECT_LT(stats.comparisons, 1000u * 30);
+    // Most comparisons resume where the tower's window starts
+    EXPECT_LT(stats.payload_read_ratio(), 0.5);
+
+    // Erasing most keys compacts the arena
+    size_t reserved = urls.arena_bytes();
+    for (int i = 0; i < 19000; ++i) {
+        EXPECT_TRUE(urls.erase("https://www.example.com/item/" + std::to_string(i)));
+    }
+    EXPECT_LT(urls.arena_bytes(), reserved);
+    EXPECT_EQ(urls.size(), 1000u);
+    EXPECT_TRUE(urls.validate());
+    EXPECT_EQ(*urls.begin(), "https://www.example.com/item/19000");
+    urls.clear();
+    EXPECT_TRUE(urls.empty());
+    EXPECT_TRUE(urls.validate());
+}
+
 // Stress Test
 TEST_F(SkipListTest, LargeDataset) {
     const int N = 10000;